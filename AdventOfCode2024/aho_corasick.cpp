@@ -0,0 +1,78 @@
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "aho_corasick.hpp"
+
+AhoCorasick::AhoCorasick(const std::vector<std::string> &words) {
+    // symbol 0 stands for every character that is in no word
+    for(const std::string &word : words) {
+        for(const char c : word) {
+            uint32_t &symbol = symbols[static_cast<unsigned char>(c)];
+            if(symbol == 0) {
+                symbol = static_cast<uint32_t>(alphabet_size++);
+            }
+        }
+    }
+
+    // trie; a transition to START_STATE means "missing" until the DFA is
+    // completed below, which is safe because no edge leads back to the root
+    std::size_t num_trie_states = 1;
+    transitions.assign(alphabet_size, START_STATE);
+    for(const std::string &word : words) {
+        std::size_t state = START_STATE;
+        for(const char c : word) {
+            const std::size_t edge =
+                state * alphabet_size + symbols[static_cast<unsigned char>(c)];
+            if(transitions[edge] == START_STATE) {
+                transitions[edge] = static_cast<uint32_t>(num_trie_states++);
+                transitions.resize(num_trie_states * alphabet_size,
+                                   START_STATE);
+            }
+            state = transitions[edge];
+        }
+        word_states.push_back(static_cast<uint32_t>(state));
+    }
+
+    // breadth-first: a state's failure link is the longest proper suffix of
+    // its string that is in the trie, and missing transitions borrow the
+    // failure state's
+    failure.assign(num_trie_states, START_STATE);
+    bfs_order.reserve(num_trie_states);
+    bfs_order.push_back(START_STATE);
+    for(std::size_t next = 0; next < bfs_order.size(); ++next) {
+        const std::size_t state = bfs_order[next];
+        for(std::size_t symbol = 1; symbol < alphabet_size; ++symbol) {
+            uint32_t &target = transitions[state * alphabet_size + symbol];
+            const uint32_t fallback =
+                (state == START_STATE)
+                    ? static_cast<uint32_t>(START_STATE)
+                    : transitions[failure[state] * alphabet_size + symbol];
+            if(target == START_STATE) {
+                target = fallback;
+            } else {
+                failure[target] = fallback;
+                bfs_order.push_back(target);
+            }
+        }
+    }
+}
+
+auto AhoCorasick::occurrences_per_word(
+    const std::vector<int64_t> &visits_per_state) const
+    -> std::vector<int64_t> {
+    std::vector<int64_t> occurrences(visits_per_state);
+    for(std::size_t i = bfs_order.size(); i-- > 1;) {
+        const uint32_t state = bfs_order[i];
+        occurrences[failure[state]] += occurrences[state];
+    }
+
+    std::vector<int64_t> counts(word_states.size(), 0);
+    for(std::size_t word = 0; word < word_states.size(); ++word) {
+        if(word_states[word] != START_STATE) {
+            counts[word] = occurrences[word_states[word]];
+        }
+    }
+    return counts;
+}
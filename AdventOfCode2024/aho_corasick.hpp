@@ -0,0 +1,61 @@
+#ifndef AHO_CORASICK_HPP
+#define AHO_CORASICK_HPP
+
+#include <array>
+#include <cstddef> // std::size_t
+#include <cstdint> // int64_t, uint32_t
+#include <string>
+#include <vector>
+
+/**
+ * Aho-Corasick automaton for finding many words at once in one pass over a
+ * text.
+ *
+ * The automaton is a complete DFA: step() is one table lookup per character.
+ * Only the characters that occur in some word get their own column, and
+ * every other character sends the automaton back to the start state.
+ *
+ * To count occurrences, record how many times the scan visits each state
+ * and pass those counts to occurrences_per_word(): a word ends wherever the
+ * scan is in a state whose failure chain reaches the word's state, so
+ * summing the visits up the failure tree (deepest states first) gives every
+ * word's count in time linear in the text plus the automaton, however many
+ * matches overlap.
+ */
+class AhoCorasick {
+  public:
+    explicit AhoCorasick(const std::vector<std::string> &words);
+
+    static constexpr std::size_t START_STATE = 0;
+
+    [[nodiscard]] auto num_states() const -> std::size_t {
+        return failure.size();
+    }
+    [[nodiscard]] auto step(const std::size_t state, const char c) const
+        -> std::size_t {
+        return transitions[state * alphabet_size +
+                           symbols[static_cast<unsigned char>(c)]];
+    }
+
+    /**
+     * Occurrences of each word (in the order given to the constructor),
+     * from the number of times a scan visited each state. Empty words never
+     * occur.
+     */
+    [[nodiscard]] auto
+    occurrences_per_word(const std::vector<int64_t> &visits_per_state) const
+        -> std::vector<int64_t>;
+
+  private:
+    static constexpr std::size_t NUM_CHARS = 256;
+
+    std::array<uint32_t, NUM_CHARS> symbols{};
+    std::size_t alphabet_size = 1;
+    std::vector<uint32_t> transitions{};
+    std::vector<uint32_t> failure{};
+    // states in breadth-first order, so failure links point earlier
+    std::vector<uint32_t> bfs_order{};
+    std::vector<uint32_t> word_states{};
+};
+
+#endif
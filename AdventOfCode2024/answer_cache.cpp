@@ -0,0 +1,64 @@
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip> // std::hex, std::setw, std::setfill
+#include <optional>
+#include <sstream>
+#include <string>
+#include <system_error> // std::error_code
+#include <utility>      // std::move
+
+#include "answer_cache.hpp"
+#include "solver_build_id.hpp"
+
+AnswerCache::AnswerCache(std::filesystem::path directory_)
+    : directory(std::move(directory_)) {}
+
+auto AnswerCache::entry_path(const AnswerCacheKey &key) const
+    -> std::filesystem::path {
+    constexpr const int HASH_HEX_DIGITS = 16;
+
+    std::stringstream ss;
+    ss << "day" << std::setw(2) << std::setfill('0') << key.day
+       << key.problem_version << '-' << SOLVER_BUILD_ID << '-' << std::hex
+       << std::setw(HASH_HEX_DIGITS) << key.input_hash;
+    return directory / ss.str();
+}
+
+auto AnswerCache::lookup(const AnswerCacheKey &key) const
+    -> std::optional<int64_t> {
+    std::ifstream entry{entry_path(key)};
+    int64_t answer = 0;
+    if(!(entry >> answer)) {
+        return std::nullopt;
+    }
+
+    return answer;
+}
+
+auto AnswerCache::store(const AnswerCacheKey &key, const int64_t answer) const
+    -> void {
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if(error) {
+        return;
+    }
+
+    // write then rename, so concurrent readers never see a partial entry
+    const std::filesystem::path path = entry_path(key);
+    std::filesystem::path temporary_path = path;
+    temporary_path += ".tmp";
+    {
+        std::ofstream entry{temporary_path};
+        entry << answer << '\n';
+        if(!entry) {
+            return;
+        }
+    }
+    std::filesystem::rename(temporary_path, path, error);
+}
+
+auto AnswerCache::clear() const -> void {
+    std::error_code error;
+    std::filesystem::remove_all(directory, error);
+}
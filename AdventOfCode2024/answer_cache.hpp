@@ -0,0 +1,40 @@
+#ifndef ANSWER_CACHE_HPP
+#define ANSWER_CACHE_HPP
+
+#include <cstddef>    // std::size_t
+#include <cstdint>    // int64_t, uint64_t
+#include <filesystem> // std::filesystem::path
+#include <optional>
+#include <string>
+
+struct AnswerCacheKey {
+    std::size_t day;
+    std::string problem_version;
+    uint64_t input_hash;
+};
+
+/**
+ * On-disk, content-addressed store of answers. An entry is keyed by
+ * (day, part, solver build id, hash of the input bytes). The build id is a
+ * hash of the solver sources, regenerated on every build, so editing an
+ * input or a solver and rebuilding never returns a stale answer. Every
+ * operation is best-effort: an unreadable or unwritable cache directory
+ * behaves like an empty cache.
+ */
+class AnswerCache {
+  public:
+    explicit AnswerCache(std::filesystem::path directory_);
+
+    [[nodiscard]] auto lookup(const AnswerCacheKey &key) const
+        -> std::optional<int64_t>;
+    auto store(const AnswerCacheKey &key, int64_t answer) const -> void;
+    auto clear() const -> void;
+
+  private:
+    [[nodiscard]] auto entry_path(const AnswerCacheKey &key) const
+        -> std::filesystem::path;
+
+    std::filesystem::path directory;
+};
+
+#endif
@@ -0,0 +1,438 @@
+#include <algorithm> // std::find_if, std::shuffle, std::sort
+#include <array>
+#include <chrono>
+#include <cstddef> // std::size_t
+#include <cstdint>
+#include <cstdlib> // std::abs
+#include <functional>
+#include <iomanip> // std::setprecision
+#include <iostream>
+#include <iterator> // std::istream_iterator
+#include <numeric> // std::iota
+#include <random>
+#include <regex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility> // std::pair
+#include <vector>
+
+#include "day.hpp"
+#include "utils.hpp"
+
+/**
+ * Benchmarks of the solvers' fast paths against the straightforward code
+ * they replaced, on generated inputs, so that the numbers can be reproduced
+ * without the puzzle inputs:
+ *
+ *   bench.out [--runs N] [--scale X] [case ...]
+ *
+ * Run r generates its input from seed r, so every variant of a case sees the
+ * same inputs, and consecutive runs never hit a solver's parsed-input cache.
+ * Generating the input is not timed. Each variant prints one line: case,
+ * variant, best and median time over the runs, and the last run's answer,
+ * which agrees across the variants of a case.
+ */
+
+struct BenchOptions {
+    std::size_t num_runs = 5;
+    // every case's default input size is multiplied by this
+    double scale = 1.0;
+};
+
+using InputMaker = std::function<std::string(std::mt19937_64 &)>;
+using Solver = std::function<int64_t(const std::string &)>;
+
+[[gnu::const]] auto scaled(const std::size_t default_size, const double scale)
+    -> std::size_t {
+    return std::max<std::size_t>(
+        1, static_cast<std::size_t>(static_cast<double>(default_size) * scale));
+}
+
+/**
+ * Time solve on options.num_runs generated inputs, each also registered as
+ * the contents of input_file_name so that the solvers read it from memory.
+ */
+auto time_variant(const BenchOptions &options, const std::string &case_name,
+                  const std::string &variant_name,
+                  const std::string &input_file_name,
+                  const InputMaker &make_input, const Solver &solve) -> void {
+    std::vector<double> milliseconds;
+    int64_t answer = 0;
+    for(std::size_t run = 0; run < options.num_runs; ++run) {
+        std::mt19937_64 rng(run);
+        const std::string input = make_input(rng);
+        clear_input_overrides();
+        set_input_override(input_file_name, input);
+
+        const auto start = std::chrono::steady_clock::now();
+        answer = solve(input);
+        const std::chrono::duration<double, std::milli> elapsed =
+            std::chrono::steady_clock::now() - start;
+        milliseconds.push_back(elapsed.count());
+    }
+
+    std::sort(milliseconds.begin(), milliseconds.end());
+    std::cout << case_name << ' ' << variant_name << std::fixed
+              << std::setprecision(2) << " best " << milliseconds.front()
+              << " ms median " << milliseconds[milliseconds.size() / 2]
+              << " ms answer " << answer << std::endl;
+}
+
+/**
+ * Day 1 on one million lines of five-digit ids: the radix sort and the
+ * merge-join against operator>>, std::sort and an unordered_map.
+ */
+auto bench_day01(const BenchOptions &options) -> void {
+    constexpr const std::size_t DEFAULT_LINES = 1000000;
+    constexpr const int MIN_ID = 10000;
+    constexpr const int MAX_ID = 99999;
+
+    const std::size_t num_lines = scaled(DEFAULT_LINES, options.scale);
+    const InputMaker make_input = [num_lines](std::mt19937_64 &rng) {
+        std::uniform_int_distribution<int> location_id(MIN_ID, MAX_ID);
+        std::string input;
+        for(std::size_t line = 0; line < num_lines; ++line) {
+            input += std::to_string(location_id(rng));
+            input += "   ";
+            input += std::to_string(location_id(rng));
+            input += '\n';
+        }
+        return input;
+    };
+    const auto read_columns = [](const std::string &input) {
+        std::istringstream stream(input);
+        std::pair<std::vector<int>, std::vector<int>> columns;
+        int first = 0;
+        int second = 0;
+        while(stream >> first >> second) {
+            columns.first.push_back(first);
+            columns.second.push_back(second);
+        }
+        return columns;
+    };
+    const std::string input_file_name = input_file_name_for_day(1);
+
+    time_variant(options, "day01a", "std::sort", input_file_name, make_input,
+                 [&read_columns](const std::string &input) {
+                     auto [list1, list2] = read_columns(input);
+                     std::sort(list1.begin(), list1.end());
+                     std::sort(list2.begin(), list2.end());
+                     int64_t total_distance = 0;
+                     for(std::size_t i = 0; i < list1.size(); ++i) {
+                         total_distance += std::abs(list1[i] - list2[i]);
+                     }
+                     return total_distance;
+                 });
+    time_variant(options, "day01a", "solver", input_file_name, make_input,
+                 [](const std::string &) { return solve_day01a(); });
+
+    time_variant(options, "day01b", "unordered_map", input_file_name,
+                 make_input, [&read_columns](const std::string &input) {
+                     const auto [list1, list2] = read_columns(input);
+                     std::unordered_map<int, int64_t> list2_counts;
+                     for(const int value : list2) {
+                         ++list2_counts[value];
+                     }
+                     int64_t score = 0;
+                     for(const int value : list1) {
+                         score += value * list2_counts[value];
+                     }
+                     return score;
+                 });
+    time_variant(options, "day01b", "solver", input_file_name, make_input,
+                 [](const std::string &) { return solve_day01b(); });
+}
+
+/**
+ * Day 2 on 5000 reports of 200 levels, a quarter of them with one bad level
+ * and a quarter with two: the linear-time problem dampener against deleting
+ * each level in turn and checking what is left.
+ */
+auto bench_day02(const BenchOptions &options) -> void {
+    constexpr const std::size_t DEFAULT_REPORTS = 5000;
+    constexpr const std::size_t LEVELS_PER_REPORT = 200;
+    constexpr const int FIRST_LEVEL = 1000;
+    constexpr const int BAD_JUMP = 10;
+
+    const std::size_t num_reports = scaled(DEFAULT_REPORTS, options.scale);
+    const InputMaker make_input = [num_reports](std::mt19937_64 &rng) {
+        std::uniform_int_distribution<int> step(1, 3);
+        std::uniform_int_distribution<int> num_bad_levels(0, 3);
+        std::uniform_int_distribution<std::size_t> bad_position(
+            0, LEVELS_PER_REPORT - 1);
+        std::bernoulli_distribution increasing(0.5);
+        std::string input;
+        for(std::size_t r = 0; r < num_reports; ++r) {
+            const int direction = increasing(rng) ? 1 : -1;
+            std::vector<int> levels(LEVELS_PER_REPORT);
+            levels[0] = FIRST_LEVEL;
+            for(std::size_t i = 1; i < levels.size(); ++i) {
+                levels[i] = levels[i - 1] + direction * step(rng);
+            }
+            // no bad level half the time, one or two a quarter of the time each
+            const int bad_levels = std::max(0, num_bad_levels(rng) - 1);
+            for(int b = 0; b < bad_levels; ++b) {
+                levels[bad_position(rng)] += BAD_JUMP;
+            }
+            for(std::size_t i = 0; i < levels.size(); ++i) {
+                input += std::to_string(levels[i]);
+                input += (i + 1 == levels.size()) ? '\n' : ' ';
+            }
+        }
+        return input;
+    };
+    const std::string input_file_name = input_file_name_for_day(2);
+
+    time_variant(
+        options, "day02b", "remove each level", input_file_name, make_input,
+        [](const std::string &input) {
+            const auto is_safe = [](const std::vector<int> &report) {
+                bool increasing = true;
+                bool decreasing = true;
+                for(std::size_t i = 1; i < report.size(); ++i) {
+                    const int step = report[i] - report[i - 1];
+                    increasing = increasing && 1 <= step && step <= 3;
+                    decreasing = decreasing && -3 <= step && step <= -1;
+                }
+                return increasing || decreasing;
+            };
+            std::istringstream lines(input);
+            std::string line;
+            int64_t count = 0;
+            while(std::getline(lines, line)) {
+                std::istringstream stream(line);
+                const std::vector<int> report{
+                    std::istream_iterator<int>(stream),
+                    std::istream_iterator<int>()};
+                bool safe = is_safe(report);
+                for(std::size_t skip = 0; !safe && skip < report.size();
+                    ++skip) {
+                    std::vector<int> shorter = report;
+                    shorter.erase(shorter.begin() +
+                                  static_cast<std::ptrdiff_t>(skip));
+                    safe = is_safe(shorter);
+                }
+                count += safe ? 1 : 0;
+            }
+            return count;
+        });
+    time_variant(options, "day02b", "solver", input_file_name, make_input,
+                 [](const std::string &) { return solve_day02b(); });
+}
+
+/**
+ * Corrupted day 3 memory of num_bytes bytes, built from pieces of
+ * instructions, operands, junk and newlines.
+ */
+auto make_day03_memory(const std::size_t num_bytes, std::mt19937_64 &rng)
+    -> std::string {
+    static const std::array<std::string, 9> pieces{
+        "mul(", ",", ")", "do()", "don't()", "mul", "(", "\n", " "};
+    std::uniform_int_distribution<std::size_t> kind(0, pieces.size() + 1);
+    // a few operands have four digits, too many for a multiplication
+    std::uniform_int_distribution<int> operand(0, 1099);
+    std::uniform_int_distribution<int> junk('!', '~');
+    std::string input;
+    while(input.size() < num_bytes) {
+        const std::size_t k = kind(rng);
+        if(k < pieces.size()) {
+            input += pieces[k];
+        } else if(k == pieces.size()) {
+            input += std::to_string(operand(rng));
+        } else {
+            input += static_cast<char>(junk(rng));
+        }
+    }
+    return input;
+}
+
+/**
+ * Day 3 on four megabytes of corrupted memory: the state machine against a
+ * std::regex for all three instructions.
+ */
+auto bench_day03(const BenchOptions &options) -> void {
+    constexpr const std::size_t DEFAULT_BYTES = std::size_t{4} << 20U;
+
+    const std::size_t num_bytes = scaled(DEFAULT_BYTES, options.scale);
+    const InputMaker make_input = [num_bytes](std::mt19937_64 &rng) {
+        return make_day03_memory(num_bytes, rng);
+    };
+    const std::string input_file_name = input_file_name_for_day(3);
+
+    time_variant(
+        options, "day03b", "std::regex", input_file_name, make_input,
+        [](const std::string &input) {
+            std::string memory = input;
+            std::erase(memory, '\n');
+            const std::regex instruction_pattern(
+                R"(mul\((\d{1,3}),(\d{1,3})\)|do\(\)|don't\(\))");
+            int64_t sum = 0;
+            bool enabled = true;
+            for(auto it = std::sregex_iterator(memory.begin(), memory.end(),
+                                               instruction_pattern);
+                it != std::sregex_iterator(); ++it) {
+                const std::string instruction = it->str();
+                if(instruction == "do()") {
+                    enabled = true;
+                } else if(instruction == "don't()") {
+                    enabled = false;
+                } else if(enabled) {
+                    sum += int64_t{std::stoi((*it)[1].str())} *
+                           std::stoi((*it)[2].str());
+                }
+            }
+            return sum;
+        });
+    time_variant(options, "day03b", "solver", input_file_name, make_input,
+                 [](const std::string &) { return solve_day03b(); });
+}
+
+/**
+ * Day 3 on 64 megabytes split into 1 to 8 chunks, one thread each. The
+ * speedup is bounded by the cores available, so check
+ * hardware_concurrency before reading these numbers.
+ */
+auto bench_day03_threads(const BenchOptions &options) -> void {
+    constexpr const std::size_t DEFAULT_BYTES = std::size_t{64} << 20U;
+    constexpr const std::size_t MAX_THREADS = 8;
+
+    const std::size_t num_bytes = scaled(DEFAULT_BYTES, options.scale);
+    const InputMaker make_input = [num_bytes](std::mt19937_64 &rng) {
+        return make_day03_memory(num_bytes, rng);
+    };
+    const std::string input_file_name = input_file_name_for_day(3);
+
+    std::cout << "day03-threads: " << std::thread::hardware_concurrency()
+              << " cores" << std::endl;
+    for(std::size_t num_threads = 1; num_threads <= MAX_THREADS;
+        num_threads *= 2) {
+        time_variant(options, "day03-threads",
+                     "threads=" + std::to_string(num_threads), input_file_name,
+                     make_input, [num_threads](const std::string &input) {
+                         return scan_day03_memory(input, num_threads).second;
+                     });
+    }
+}
+
+/**
+ * Day 5 on rules that totally order 400 pages, one per pair, and 1500
+ * shuffled manuals of 101 pages: the solver against checking each manual
+ * and std::sort with a set of rules as the comparator.
+ */
+auto bench_day05(const BenchOptions &options) -> void {
+    constexpr const int NUM_PAGES = 400;
+    constexpr const int FIRST_PAGE = 100;
+    constexpr const std::size_t DEFAULT_MANUALS = 1500;
+    constexpr const std::size_t PAGES_PER_MANUAL = 101;
+
+    const std::size_t num_manuals = scaled(DEFAULT_MANUALS, options.scale);
+    const InputMaker make_input = [num_manuals](std::mt19937_64 &rng) {
+        std::vector<int> pages(NUM_PAGES);
+        std::iota(pages.begin(), pages.end(), FIRST_PAGE);
+        std::shuffle(pages.begin(), pages.end(), rng);
+        std::vector<std::string> rules;
+        for(std::size_t i = 0; i < pages.size(); ++i) {
+            for(std::size_t j = i + 1; j < pages.size(); ++j) {
+                rules.push_back(std::to_string(pages[i]) + '|' +
+                                std::to_string(pages[j]) + '\n');
+            }
+        }
+        std::shuffle(rules.begin(), rules.end(), rng);
+
+        std::string input;
+        for(const std::string &rule : rules) {
+            input += rule;
+        }
+        input += '\n';
+        for(std::size_t m = 0; m < num_manuals; ++m) {
+            std::shuffle(pages.begin(), pages.end(), rng);
+            for(std::size_t i = 0; i < PAGES_PER_MANUAL; ++i) {
+                input += std::to_string(pages[i]);
+                input += (i + 1 == PAGES_PER_MANUAL) ? '\n' : ',';
+            }
+        }
+        return input;
+    };
+    const std::string input_file_name = input_file_name_for_day(5);
+
+    time_variant(
+        options, "day05b", "std::sort", input_file_name, make_input,
+        [](const std::string &input) {
+            std::istringstream lines(input);
+            std::string line;
+            std::set<std::pair<int, int>> rules;
+            while(std::getline(lines, line) && !line.empty()) {
+                const std::size_t bar = line.find('|');
+                rules.emplace(std::stoi(line.substr(0, bar)),
+                              std::stoi(line.substr(bar + 1)));
+            }
+            const auto precedes = [&rules](const int a, const int b) {
+                return rules.contains({a, b});
+            };
+            int64_t sum_middle = 0;
+            while(std::getline(lines, line)) {
+                std::vector<int> manual;
+                for(const std::string &page : split(line, ',')) {
+                    manual.push_back(std::stoi(page));
+                }
+                if(!std::is_sorted(manual.begin(), manual.end(), precedes)) {
+                    std::sort(manual.begin(), manual.end(), precedes);
+                    sum_middle += manual[manual.size() / 2];
+                }
+            }
+            return sum_middle;
+        });
+    time_variant(options, "day05b", "solver", input_file_name, make_input,
+                 [](const std::string &) { return solve_day05b(); });
+}
+
+auto main(int argc, char *argv[]) -> int {
+    const std::array<std::pair<const char *, void (*)(const BenchOptions &)>,
+                     5>
+        cases{{{"day01", &bench_day01},
+               {"day02", &bench_day02},
+               {"day03", &bench_day03},
+               {"day03-threads", &bench_day03_threads},
+               {"day05", &bench_day05}}};
+
+    const std::vector<std::string> args(argv, argv + argc);
+    BenchOptions options;
+    std::vector<std::string> selected;
+    for(std::size_t i = 1; i < args.size(); ++i) {
+        if(args[i] == "--runs" || args[i] == "--scale") {
+            if(i + 1 == args.size()) {
+                std::cerr << args[i] << " requires an argument" << std::endl;
+                return 1;
+            }
+            if(args[i] == "--runs") {
+                options.num_runs = std::max<std::size_t>(
+                    1, std::stoull(args[++i]));
+            } else {
+                options.scale = std::stod(args[++i]);
+            }
+        } else {
+            selected.push_back(args[i]);
+        }
+    }
+
+    for(const std::string &name : selected) {
+        const auto it = std::find_if(cases.begin(), cases.end(),
+                                     [&name](const auto &bench_case) {
+                                         return name == bench_case.first;
+                                     });
+        if(it == cases.end()) {
+            std::cerr << "Unknown benchmark " << name << std::endl;
+            return 1;
+        }
+    }
+    for(const auto &[name, run] : cases) {
+        if(selected.empty() || std::find(selected.begin(), selected.end(),
+                                         name) != selected.end()) {
+            run(options);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,127 @@
+#include <algorithm> // std::fill
+#include <bit>       // std::popcount
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "bit_grid.hpp"
+
+BitGrid::BitGrid(const std::size_t num_rows_, const std::size_t num_cols_)
+    : rows(num_rows_), cols(num_cols_),
+      row_words((num_cols_ + WORD_BITS - 1) / WORD_BITS),
+      words(num_rows_ * row_words, 0) {}
+
+auto BitGrid::clear() -> void { std::fill(words.begin(), words.end(), 0); }
+
+auto BitGrid::count() const -> std::size_t {
+    std::size_t total = 0;
+    for(const uint64_t word : words) {
+        total += static_cast<std::size_t>(std::popcount(word));
+    }
+    return total;
+}
+
+auto BitGrid::count_and(const BitGrid &other) const -> std::size_t {
+    std::size_t total = 0;
+    for(std::size_t i = 0; i < words.size(); ++i) {
+        total += static_cast<std::size_t>(
+            std::popcount(words[i] & other.words[i]));
+    }
+    return total;
+}
+
+auto BitGrid::operator&=(const BitGrid &other) -> BitGrid & {
+    for(std::size_t i = 0; i < words.size(); ++i) {
+        words[i] &= other.words[i];
+    }
+    return *this;
+}
+
+auto BitGrid::operator|=(const BitGrid &other) -> BitGrid & {
+    for(std::size_t i = 0; i < words.size(); ++i) {
+        words[i] |= other.words[i];
+    }
+    return *this;
+}
+
+auto BitGrid::or_row_shifted(const std::size_t destination_row,
+                             const BitGrid &other,
+                             const std::size_t source_row,
+                             const int col_offset) -> void {
+    uint64_t *destination = &words[destination_row * row_words];
+    const uint64_t *source = other.row_data(source_row);
+
+    if(col_offset >= 0) {
+        // columns move right: bits move towards the high end of the row
+        const auto offset = static_cast<std::size_t>(col_offset);
+        const std::size_t word_shift = offset / WORD_BITS;
+        const std::size_t bit_shift = offset % WORD_BITS;
+        for(std::size_t i = word_shift; i < row_words; ++i) {
+            const std::size_t j = i - word_shift;
+            uint64_t value = source[j] << bit_shift;
+            if(bit_shift != 0 && j > 0) {
+                value |= source[j - 1] >> (WORD_BITS - bit_shift);
+            }
+            destination[i] |= value;
+        }
+        mask_last_word(destination_row);
+    } else {
+        const auto offset = static_cast<std::size_t>(-col_offset);
+        const std::size_t word_shift = offset / WORD_BITS;
+        const std::size_t bit_shift = offset % WORD_BITS;
+        for(std::size_t i = 0; i + word_shift < row_words; ++i) {
+            const std::size_t j = i + word_shift;
+            uint64_t value = source[j] >> bit_shift;
+            if(bit_shift != 0 && j + 1 < row_words) {
+                value |= source[j + 1] << (WORD_BITS - bit_shift);
+            }
+            destination[i] |= value;
+        }
+    }
+}
+
+auto BitGrid::mask_last_word(const std::size_t row) -> void {
+    const std::size_t used_bits = cols % WORD_BITS;
+    if(used_bits != 0) {
+        words[row * row_words + row_words - 1] &=
+            (uint64_t{1} << used_bits) - 1;
+    }
+}
+
+auto BitGrid::or_shifted(const BitGrid &other, const int row_offset,
+                         const int col_offset) -> void {
+    for(std::size_t source_row = 0; source_row < rows; ++source_row) {
+        const auto destination_row =
+            static_cast<int64_t>(source_row) + row_offset;
+        if(destination_row < 0 ||
+           destination_row >= static_cast<int64_t>(rows)) {
+            continue;
+        }
+        or_row_shifted(static_cast<std::size_t>(destination_row), other,
+                       source_row, col_offset);
+    }
+}
+
+auto BitGrid::or_rotated(const BitGrid &other, const int row_offset,
+                         const int col_offset) -> void {
+    if(rows == 0 || cols == 0) {
+        return;
+    }
+    const auto signed_rows = static_cast<int64_t>(rows);
+    const auto signed_cols = static_cast<int>(cols);
+    // normalize into [0, cols) so the wrapped part is a single left shift
+    const int right_shift =
+        ((col_offset % signed_cols) + signed_cols) % signed_cols;
+
+    for(std::size_t source_row = 0; source_row < rows; ++source_row) {
+        const auto destination_row = static_cast<std::size_t>(
+            ((static_cast<int64_t>(source_row) + row_offset) % signed_rows +
+             signed_rows) %
+            signed_rows);
+        or_row_shifted(destination_row, other, source_row, right_shift);
+        if(right_shift != 0) {
+            or_row_shifted(destination_row, other, source_row,
+                           right_shift - signed_cols);
+        }
+    }
+}
@@ -0,0 +1,96 @@
+#ifndef BIT_GRID_HPP
+#define BIT_GRID_HPP
+
+#include <cstddef> // std::size_t
+#include <cstdint> // uint64_t
+#include <vector>
+
+/**
+ * Packed 2D bitset for visited sets and occupancy grids. Each row starts on a
+ * fresh 64-bit word, so whole-row operations never straddle rows and bits
+ * past the last column are always zero.
+ *
+ * Besides per-cell access, the grid supports word-at-a-time AND/OR with
+ * another grid of the same shape, OR-ing in a shifted (or wrapped-around)
+ * copy of another grid, and popcount. Neighbor tests then become a handful
+ * of whole-grid operations instead of a per-cell loop.
+ */
+class BitGrid {
+  public:
+    BitGrid(std::size_t num_rows_, std::size_t num_cols_);
+
+    [[nodiscard]] auto num_rows() const -> std::size_t { return rows; }
+    [[nodiscard]] auto num_cols() const -> std::size_t { return cols; }
+    [[nodiscard]] auto words_per_row() const -> std::size_t {
+        return row_words;
+    }
+
+    [[nodiscard]] auto test(const std::size_t row, const std::size_t col) const
+        -> bool {
+        return ((words[row * row_words + col / WORD_BITS] >>
+                 (col % WORD_BITS)) &
+                1U) != 0;
+    }
+    auto set(const std::size_t row, const std::size_t col) -> void {
+        words[row * row_words + col / WORD_BITS] |= uint64_t{1}
+                                                    << (col % WORD_BITS);
+    }
+    auto reset(const std::size_t row, const std::size_t col) -> void {
+        words[row * row_words + col / WORD_BITS] &=
+            ~(uint64_t{1} << (col % WORD_BITS));
+    }
+
+    /**
+     * Set every bit to zero, keeping the allocation. O(words).
+     */
+    auto clear() -> void;
+
+    /**
+     * Number of set bits.
+     */
+    [[nodiscard, gnu::pure]] auto count() const -> std::size_t;
+
+    /**
+     * Number of bits set in both this grid and other, without materializing
+     * the intersection.
+     */
+    [[nodiscard, gnu::pure]] auto count_and(const BitGrid &other) const
+        -> std::size_t;
+
+    auto operator&=(const BitGrid &other) -> BitGrid &;
+    auto operator|=(const BitGrid &other) -> BitGrid &;
+
+    /**
+     * this |= other moved down by row_offset rows and right by col_offset
+     * columns (negative offsets move up / left). Cells shifted off the grid
+     * are dropped. other must have the same shape and must not be *this.
+     */
+    auto or_shifted(const BitGrid &other, int row_offset, int col_offset)
+        -> void;
+
+    /**
+     * Like or_shifted, but cells shifted off one edge wrap around to the
+     * opposite edge (the grid is a torus).
+     */
+    auto or_rotated(const BitGrid &other, int row_offset, int col_offset)
+        -> void;
+
+    [[nodiscard]] auto row_data(const std::size_t row) const
+        -> const uint64_t * {
+        return &words[row * row_words];
+    }
+
+  private:
+    static constexpr std::size_t WORD_BITS = 64;
+
+    auto or_row_shifted(std::size_t destination_row, const BitGrid &other,
+                        std::size_t source_row, int col_offset) -> void;
+    auto mask_last_word(std::size_t row) -> void;
+
+    std::size_t rows;
+    std::size_t cols;
+    std::size_t row_words;
+    std::vector<uint64_t> words;
+};
+
+#endif
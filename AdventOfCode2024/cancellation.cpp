@@ -0,0 +1,46 @@
+#include <atomic>
+#include <chrono>
+
+#include "cancellation.hpp"
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+static thread_local const CancellationToken *current_token = nullptr;
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+static thread_local unsigned int calls_until_check = 0;
+
+CancellationToken::CancellationToken(const Clock::duration budget)
+    : deadline(Clock::now() + budget) {}
+
+auto CancellationToken::cancel() -> void {
+    cancelled.store(true, std::memory_order_relaxed);
+}
+
+auto CancellationToken::is_cancelled() const -> bool {
+    return cancelled.load(std::memory_order_relaxed) ||
+           (deadline.has_value() && Clock::now() >= *deadline);
+}
+
+auto SolveCancelled::what() const noexcept -> const char * {
+    return "solve cancelled";
+}
+
+CancellationScope::CancellationScope(const CancellationToken &token)
+    : previous_token(current_token) {
+    current_token = &token;
+    calls_until_check = 0;
+}
+
+CancellationScope::~CancellationScope() { current_token = previous_token; }
+
+auto check_cancellation() -> void {
+    constexpr const unsigned int CALLS_PER_CHECK = 256;
+
+    if(calls_until_check > 0) {
+        --calls_until_check;
+        return;
+    }
+    calls_until_check = CALLS_PER_CHECK;
+    if(current_token != nullptr && current_token->is_cancelled()) {
+        throw SolveCancelled();
+    }
+}
@@ -0,0 +1,63 @@
+#ifndef CANCELLATION_HPP
+#define CANCELLATION_HPP
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <optional>
+
+/**
+ * Cooperative cancellation for solvers that can run unbounded on bad input.
+ *
+ * The driver installs a token (optionally with a deadline) for the duration
+ * of one solve with CancellationScope. Long-running loops call
+ * check_cancellation(), which throws SolveCancelled once the token has been
+ * cancelled or its deadline has passed. Solvers keep their int64_t()
+ * signature and need no cleanup code: unwinding releases everything.
+ */
+class CancellationToken {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    CancellationToken() = default;
+    explicit CancellationToken(Clock::duration budget);
+
+    auto cancel() -> void;
+    [[nodiscard]] auto is_cancelled() const -> bool;
+
+  private:
+    std::atomic<bool> cancelled{false};
+    std::optional<Clock::time_point> deadline{};
+};
+
+class SolveCancelled : public std::exception {
+  public:
+    [[nodiscard, gnu::const]] auto what() const noexcept
+        -> const char * override;
+};
+
+/**
+ * Makes token the one check_cancellation() consults on this thread, until
+ * the scope ends.
+ */
+class CancellationScope {
+  public:
+    explicit CancellationScope(const CancellationToken &token);
+    ~CancellationScope();
+
+    CancellationScope(const CancellationScope &) = delete;
+    CancellationScope(CancellationScope &&) = delete;
+    auto operator=(const CancellationScope &) -> CancellationScope & = delete;
+    auto operator=(CancellationScope &&) -> CancellationScope & = delete;
+
+  private:
+    const CancellationToken *previous_token;
+};
+
+/**
+ * Throws SolveCancelled if the current token is cancelled. Cheap enough for
+ * inner loops: the clock is only read every few hundred calls.
+ */
+auto check_cancellation() -> void;
+
+#endif
@@ -1,18 +1,90 @@
 #ifndef DAY_HPP
 #define DAY_HPP
 
+#include <cstddef> // std::size_t
 #include <cstdint> // int64_t
+#include <functional>
+#include <istream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility> // std::pair
+#include <vector>
 
 auto solve_day01a() -> int64_t;
 auto solve_day01b() -> int64_t;
+/**
+ * Day 1 part B over a feed of location pairs too long to hold in memory,
+ * read chunk_bytes at a time. Counts of values below dense_limit live in a
+ * flat array and the rest in a hash table; report(pairs so far, score so
+ * far) is called after every chunk. Returns the final score. Throws
+ * std::out_of_range on a location id that does not fit in an int.
+ */
+auto stream_day01_similarity(
+    std::istream &feed, std::size_t chunk_bytes, std::size_t dense_limit,
+    const std::function<void(std::size_t, int64_t)> &report) -> int64_t;
 auto solve_day02a() -> int64_t;
 auto solve_day02b() -> int64_t;
+/**
+ * Day 2 with a problem dampener that may delete up to max_removals levels
+ * per report: whether one report can be made safe, and how many reports of
+ * the day 2 input can (0 and 1 give parts A and B).
+ */
+auto report_is_safe_with_removals(std::span<const int> report,
+                                  std::size_t max_removals) -> bool;
+auto count_day02_safe_reports(std::size_t max_removals) -> int64_t;
 auto solve_day03a() -> int64_t;
 auto solve_day03b() -> int64_t;
+/**
+ * Day 3 parts A and B over a whole memory dump, scanned in num_threads
+ * chunks in parallel.
+ */
+auto scan_day03_memory(std::string_view memory, std::size_t num_threads)
+    -> std::pair<int64_t, int64_t>;
+/**
+ * The same over a feed of any length, read buffer_bytes at a time.
+ */
+auto stream_day03_memory(std::istream &feed, std::size_t buffer_bytes)
+    -> std::pair<int64_t, int64_t>;
 auto solve_day04a() -> int64_t;
 auto solve_day04b() -> int64_t;
+/**
+ * How often each word appears in the day 4 grid, reading in any of the
+ * eight directions; all words are found in one pass per direction.
+ */
+auto count_day04_words(const std::vector<std::string> &words)
+    -> std::vector<int64_t>;
+/**
+ * Day 4 parts A and B over a grid of any size, split into row bands that
+ * are searched on num_threads threads.
+ */
+auto scan_day04_grid(std::string_view text, std::size_t num_threads)
+    -> std::pair<int64_t, int64_t>;
 auto solve_day05a() -> int64_t;
 auto solve_day05b() -> int64_t;
+/**
+ * Day 5 rule sets over at most max_pages pages are also kept as a dense bit
+ * matrix (4096 unless set); larger ones only use a sparse graph.
+ */
+auto set_day05_max_dense_rule_pages(std::size_t max_pages) -> void;
+/**
+ * One change to the day 5 rules: add or remove the rule before|after.
+ */
+struct Day05RuleUpdate {
+    bool add = true;
+    int before = 0;
+    int after = 0;
+};
+/**
+ * Day 5 parts A and B while the rules change under the input's manuals. An
+ * update only revisits the manuals holding both of its pages.
+ * report(updates applied so far, part A, part B) is called before the first
+ * update and after each one. Returns the final sums.
+ */
+auto replay_day05_rule_updates(
+    const std::vector<Day05RuleUpdate> &updates,
+    const std::function<void(std::size_t, int64_t, int64_t)> &report)
+    -> std::pair<int64_t, int64_t>;
 auto solve_day06a() -> int64_t;
 auto solve_day06b() -> int64_t;
 auto solve_day07a() -> int64_t;
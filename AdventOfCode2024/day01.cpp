@@ -1,17 +1,25 @@
 #include <algorithm>
+#include <array>
+#include <cstddef>
 #include <cstdint>
-#include <cstdlib>
-#include <fstream>
+#include <functional>
+#include <istream>
+#include <limits> // std::numeric_limits
+#include <optional>
+#include <sstream>
+#include <stdexcept> // std::out_of_range
 #include <string>
-#include <unordered_map>
+#include <thread>
 #include <utility>
 #include <vector>
 
 #include "day.hpp"
+#include "flat_hash_map.hpp"
+#include "utils.hpp"
 
-static auto parse_input() -> std::pair<std::vector<int>, std::vector<int>> {
-    const std::string input_file_name{"data/day01.txt"};
-    std::ifstream input_file{input_file_name};
+static auto parse_input(const std::string &input_text)
+    -> std::pair<std::vector<int>, std::vector<int>> {
+    std::istringstream input_file(input_text);
 
     std::vector<int> list1;
     std::vector<int> list2;
@@ -30,38 +38,272 @@ static auto parse_input() -> std::pair<std::vector<int>, std::vector<int>> {
     return std::pair<std::vector<int>, std::vector<int>>(list1, list2);
 }
 
-auto solve_day01a() -> int64_t {
-    const std::pair<std::vector<int>, std::vector<int>> input_data =
-        parse_input();
-    std::vector<int> list1 = input_data.first;
-    std::vector<int> list2 = input_data.second;
+/**
+ * LSD radix sort of non-negative values, 11 bits per pass. The histograms
+ * for all passes are built in a single sweep, and a pass is skipped when
+ * every value has the same digit there, so location ids below 2^22 need only
+ * two passes.
+ */
+auto radix_sort(std::vector<int> &values) -> void {
+    constexpr const unsigned int KEY_BITS = 32;
+    constexpr const unsigned int RADIX_BITS = 11;
+    constexpr const std::size_t NUM_BUCKETS = std::size_t{1} << RADIX_BITS;
+    constexpr const unsigned int NUM_PASSES =
+        (KEY_BITS + RADIX_BITS - 1) / RADIX_BITS;
+    constexpr const uint32_t DIGIT_MASK = NUM_BUCKETS - 1;
+
+    if(values.empty()) {
+        return;
+    }
+
+    std::array<std::array<std::size_t, NUM_BUCKETS>, NUM_PASSES> counts{};
+    for(const int value : values) {
+        const auto key = static_cast<uint32_t>(value);
+        for(unsigned int pass = 0; pass < NUM_PASSES; ++pass) {
+            ++counts[pass][(key >> (pass * RADIX_BITS)) & DIGIT_MASK];
+        }
+    }
+
+    std::vector<int> buffer(values.size());
+    for(unsigned int pass = 0; pass < NUM_PASSES; ++pass) {
+        const unsigned int shift = pass * RADIX_BITS;
+        const uint32_t first_digit =
+            (static_cast<uint32_t>(values[0]) >> shift) & DIGIT_MASK;
+        if(counts[pass][first_digit] == values.size()) {
+            continue;
+        }
+
+        std::array<std::size_t, NUM_BUCKETS> offsets{};
+        std::size_t offset = 0;
+        for(std::size_t digit = 0; digit < NUM_BUCKETS; ++digit) {
+            offsets[digit] = offset;
+            offset += counts[pass][digit];
+        }
+        for(const int value : values) {
+            const uint32_t digit =
+                (static_cast<uint32_t>(value) >> shift) & DIGIT_MASK;
+            buffer[offsets[digit]++] = value;
+        }
+        values.swap(buffer);
+    }
+}
 
-    std::sort(list1.begin(), list1.end());
-    std::sort(list2.begin(), list2.end());
+/**
+ * Sort both columns. Location ids are non-negative, so this is normally a
+ * radix sort, with the two columns sorted on separate threads when they are
+ * long enough to pay for one; std::sort handles anything else.
+ */
+auto sort_columns(std::vector<int> &list1, std::vector<int> &list2) -> void {
+    constexpr const std::size_t MIN_SIZE_FOR_THREAD = std::size_t{1} << 16U;
+
+    const auto is_negative = [](const int value) { return value < 0; };
+    if(std::any_of(list1.begin(), list1.end(), is_negative) ||
+       std::any_of(list2.begin(), list2.end(), is_negative)) {
+        std::sort(list1.begin(), list1.end());
+        std::sort(list2.begin(), list2.end());
+        return;
+    }
+
+    if(list1.size() + list2.size() < 2 * MIN_SIZE_FOR_THREAD) {
+        radix_sort(list1);
+        radix_sort(list2);
+        return;
+    }
+    std::thread list2_sorter([&list2]() { radix_sort(list2); });
+    radix_sort(list1);
+    list2_sorter.join();
+}
+
+/**
+ * Sum of |a[i] - b[i]|. Widening before subtracting keeps the loop free of
+ * overflow checks, so it vectorizes.
+ */
+[[gnu::pure]] auto sum_of_distances(const std::vector<int> &list1,
+                                    const std::vector<int> &list2) -> int64_t {
+    const std::size_t size = std::min(list1.size(), list2.size());
+    const int *a = list1.data();
+    const int *b = list2.data();
 
     int64_t total_distance = 0;
-    for(std::size_t i = 0; i < list1.size(); ++i) {
-        total_distance += std::abs(list1[i] - list2[i]);
+    for(std::size_t i = 0; i < size; ++i) {
+        const int64_t difference =
+            static_cast<int64_t>(a[i]) - static_cast<int64_t>(b[i]);
+        total_distance += (difference < 0) ? -difference : difference;
     }
 
     return total_distance;
 }
 
+/**
+ * Both columns of the input, sorted. Both parts only need the sorted
+ * columns, so the last input's are kept, keyed like the answer cache by the
+ * hash and length of the input text: solving both parts of the same input
+ * (batch and --all runs, watch mode) parses and sorts it only once, without
+ * keeping a second copy of the text around.
+ */
+auto get_sorted_columns()
+    -> const std::pair<std::vector<int>, std::vector<int>> & {
+    static std::optional<std::pair<uint64_t, std::size_t>> cached_input_key;
+    static std::pair<std::vector<int>, std::vector<int>> sorted_columns;
+
+    const std::string input_text = read_input("data/day01.txt");
+    const std::pair<uint64_t, std::size_t> input_key{hash_bytes(input_text),
+                                                     input_text.size()};
+    if(cached_input_key != input_key) {
+        sorted_columns = parse_input(input_text);
+        sort_columns(sorted_columns.first, sorted_columns.second);
+        cached_input_key = input_key;
+    }
+    return sorted_columns;
+}
+
+/**
+ * Sum of value * (occurrences in list1) * (occurrences in list2) over all
+ * values, as one merge-join over the sorted lists: no hashing and no
+ * allocation.
+ */
+[[gnu::pure]] auto similarity_score(const std::vector<int> &sorted_list1,
+                                    const std::vector<int> &sorted_list2)
+    -> int64_t {
+    int64_t score = 0;
+    std::size_t i = 0;
+    std::size_t j = 0;
+    while(i < sorted_list1.size() && j < sorted_list2.size()) {
+        const int value = sorted_list1[i];
+        if(value < sorted_list2[j]) {
+            ++i;
+        } else if(sorted_list2[j] < value) {
+            ++j;
+        } else {
+            int64_t count1 = 0;
+            for(; i < sorted_list1.size() && sorted_list1[i] == value; ++i) {
+                ++count1;
+            }
+            int64_t count2 = 0;
+            for(; j < sorted_list2.size() && sorted_list2[j] == value; ++j) {
+                ++count2;
+            }
+            score += value * count1 * count2;
+        }
+    }
+
+    return score;
+}
+
+auto solve_day01a() -> int64_t {
+    const std::pair<std::vector<int>, std::vector<int>> &columns =
+        get_sorted_columns();
+    return sum_of_distances(columns.first, columns.second);
+}
+
 auto solve_day01b() -> int64_t {
-    const std::pair<std::vector<int>, std::vector<int>> input_data =
-        parse_input();
-    std::vector<int> list1 = input_data.first;
-    std::vector<int> list2 = input_data.second;
-
-    std::unordered_map<int, int> list2_counts;
-    for(const int value : list2) {
-        list2_counts[value]++;
+    const std::pair<std::vector<int>, std::vector<int>> &columns =
+        get_sorted_columns();
+    return similarity_score(columns.first, columns.second);
+}
+
+/**
+ * Exact similarity score over a feed of location pairs, kept up to date as
+ * values arrive: the score is the sum over v of v * left(v) * right(v), so a
+ * new left value v adds v * right(v) and a new right value adds v * left(v).
+ *
+ * Memory is bounded by the number of distinct values, not the feed length.
+ * Values in [0, dense_limit) are counted in a flat array; rarer values
+ * outside that range spill to a FlatHashMap.
+ */
+class StreamingSimilarity {
+  public:
+    explicit StreamingSimilarity(const std::size_t dense_limit)
+        : dense_counts(dense_limit) {}
+
+    auto add_left(const int value) -> void {
+        LocationCounts &counts = counts_for(value);
+        score += value * counts.right;
+        ++counts.left;
     }
 
-    int64_t similarity_score = 0;
-    for(const int value : list1) {
-        similarity_score += value * list2_counts[value];
+    auto add_right(const int value) -> void {
+        LocationCounts &counts = counts_for(value);
+        score += value * counts.left;
+        ++counts.right;
+    }
+
+    [[nodiscard]] auto get_score() const -> int64_t { return score; }
+
+  private:
+    struct LocationCounts {
+        int64_t left = 0;
+        int64_t right = 0;
+    };
+
+    auto counts_for(const int value) -> LocationCounts & {
+        const auto index = static_cast<std::size_t>(value);
+        if(0 <= value && index < dense_counts.size()) {
+            return dense_counts[index];
+        }
+        return sparse_counts[value];
+    }
+
+    std::vector<LocationCounts> dense_counts;
+    FlatHashMap<int, LocationCounts> sparse_counts{};
+    int64_t score = 0;
+};
+
+auto stream_day01_similarity(
+    std::istream &feed, const std::size_t chunk_bytes,
+    const std::size_t dense_limit,
+    const std::function<void(std::size_t, int64_t)> &report) -> int64_t {
+    StreamingSimilarity similarity(dense_limit);
+    std::vector<char> chunk(std::max(chunk_bytes, std::size_t{1}));
+
+    // numbers alternate left, right, left, ... and may straddle chunks
+    bool next_is_left = true;
+    bool in_number = false;
+    bool negative = false;
+    int64_t value = 0;
+    std::size_t num_pairs = 0;
+    constexpr const int64_t MAX_LOCATION_ID = std::numeric_limits<int>::max();
+    const auto finish_number = [&]() {
+        if(!in_number) {
+            return;
+        }
+        const auto location_id = static_cast<int>(negative ? -value : value);
+        if(next_is_left) {
+            similarity.add_left(location_id);
+        } else {
+            similarity.add_right(location_id);
+            ++num_pairs;
+        }
+        next_is_left = !next_is_left;
+        in_number = false;
+        negative = false;
+        value = 0;
+    };
+
+    while(feed) {
+        feed.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+        const auto num_read = static_cast<std::size_t>(feed.gcount());
+        for(std::size_t i = 0; i < num_read; ++i) {
+            const char c = chunk[i];
+            if('0' <= c && c <= '9') {
+                in_number = true;
+                value = 10 * value + (c - '0');
+                if(value > MAX_LOCATION_ID + (negative ? 1 : 0)) {
+                    throw std::out_of_range(
+                        "Location id does not fit in an int");
+                }
+            } else {
+                finish_number();
+                // a sign only counts if a digit follows it directly
+                negative = (c == '-');
+            }
+        }
+        if(feed) {
+            report(num_pairs, similarity.get_score());
+        }
     }
+    finish_number();
+    report(num_pairs, similarity.get_score());
 
-    return similarity_score;
+    return similarity.get_score();
 }
@@ -1,7 +1,11 @@
-#include <cstdlib>
-#include <fstream>
-#include <iterator>
+#include <algorithm> // std::clamp, std::max, std::min
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <numeric> // std::accumulate
+#include <span>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "day.hpp"
@@ -10,43 +14,165 @@
 constexpr const int INCREASE_LOWER_BOUND = 1;
 constexpr const int INCREASE_UPPER_BOUND = 3;
 
-static auto parse_input() -> std::vector<std::vector<int>> {
-    const std::string input_file_name{"data/day02.txt"};
-    std::ifstream input_file{input_file_name};
-
-    std::vector<std::vector<int>> input;
-    std::string line;
-    while(std::getline(input_file, line)) {
-        const std::vector<std::string> tokens = split(line, ' ');
-        std::vector<int> line_ints(tokens.size());
-        for(std::size_t i = 0; i < tokens.size(); ++i) {
-            const std::string token = tokens[i];
-            line_ints[i] = std::stoi(token);
+constexpr const uint8_t SAFE_INCREASING = 1;
+constexpr const uint8_t SAFE_DECREASING = 2;
+
+/**
+ * Every report's levels back to back in one array: report r is
+ * levels[offsets[r] .. offsets[r + 1]).
+ */
+struct Reports {
+    Reports();
+    Reports(const Reports &other);
+    Reports(Reports &&other) noexcept;
+    auto operator=(const Reports &other) -> Reports &;
+    auto operator=(Reports &&other) noexcept -> Reports &;
+    ~Reports();
+
+    std::vector<int> levels{};
+    std::vector<std::size_t> offsets{0};
+
+    [[nodiscard]] auto size() const -> std::size_t {
+        return offsets.size() - 1;
+    }
+};
+
+// out of line: -Winline reports the implicit destructor on cold paths
+Reports::Reports() = default;
+Reports::Reports(const Reports &other) = default;
+Reports::Reports(Reports &&other) noexcept = default;
+auto Reports::operator=(const Reports &other) -> Reports & = default;
+auto Reports::operator=(Reports &&other) noexcept -> Reports & = default;
+Reports::~Reports() = default;
+
+static auto parse_input() -> Reports {
+    const std::string input_text = read_input("data/day02.txt");
+
+    Reports reports;
+    bool in_number = false;
+    bool negative = false;
+    int value = 0;
+    const auto finish_number = [&]() {
+        if(in_number) {
+            reports.levels.push_back(negative ? -value : value);
+        }
+        in_number = false;
+        negative = false;
+        value = 0;
+    };
+
+    for(const char c : input_text) {
+        if('0' <= c && c <= '9') {
+            value = 10 * value + (c - '0');
+            in_number = true;
+        } else if(c == '-') {
+            negative = true;
+        } else {
+            finish_number();
+            if(c == '\n') {
+                reports.offsets.push_back(reports.levels.size());
+            }
         }
-        input.push_back(line_ints);
+    }
+    finish_number();
+    if(!input_text.empty() && input_text.back() != '\n') {
+        reports.offsets.push_back(reports.levels.size());
     }
 
-    return input;
+    return reports;
 }
 
-auto report_is_safe(const std::vector<int> &report) -> bool {
-    if(report.size() < 2) {
-        return true;
+[[gnu::const]] auto step_is_safe(const int from, const int to,
+                                 const bool increasing) -> bool {
+    const int diff = increasing ? (to - from) : (from - to);
+    return INCREASE_LOWER_BOUND <= diff && diff <= INCREASE_UPPER_BOUND;
+}
+
+/**
+ * Classify every step levels[i] -> levels[i + 1] in one pass: step_flags[i]
+ * has SAFE_INCREASING set if the step rises by a safe amount and
+ * SAFE_DECREASING if it falls by one. The loop is branch-free so that it
+ * vectorizes. Steps from the last level of one report to the first level of
+ * the next are classified as well and never looked at.
+ */
+auto classify_steps(const std::span<const int> levels,
+                    std::vector<uint8_t> &step_flags) -> void {
+    constexpr const auto SAFE_RANGE =
+        static_cast<unsigned int>(INCREASE_UPPER_BOUND - INCREASE_LOWER_BOUND);
+
+    // a local bound: stores through a uint8_t pointer could alias the
+    // vector's own size, which would stop the loop from vectorizing
+    const std::size_t num_steps = levels.size() < 2 ? 0 : levels.size() - 1;
+    step_flags.resize(num_steps);
+    const int *level = levels.data();
+    uint8_t *flags = step_flags.data();
+    for(std::size_t i = 0; i < num_steps; ++i) {
+        const int diff = level[i + 1] - level[i];
+        // unsigned wrap-around turns each range check into one comparison
+        const bool rises =
+            static_cast<unsigned int>(diff - INCREASE_LOWER_BOUND) <=
+            SAFE_RANGE;
+        const bool falls =
+            static_cast<unsigned int>(-diff - INCREASE_LOWER_BOUND) <=
+            SAFE_RANGE;
+        flags[i] = static_cast<uint8_t>((rises ? SAFE_INCREASING : 0) |
+                                        (falls ? SAFE_DECREASING : 0));
+    }
+}
+
+/**
+ * A report is safe if all of its steps are safe in the same direction.
+ */
+[[gnu::pure]] auto report_is_safe(const std::span<const uint8_t> steps)
+    -> bool {
+    uint8_t common_directions = SAFE_INCREASING | SAFE_DECREASING;
+    for(const uint8_t step : steps) {
+        common_directions &= step;
     }
 
-    const bool initial_increasing = (report[0] < report[1]);
-    for(std::size_t i = 1; i < report.size(); ++i) {
-        const int diff = report[i] - report[i - 1];
-        const bool currently_increasing = (diff > 0);
+    return common_directions != 0;
+}
+
+/**
+ * Whether removing at most one level leaves every step moving in the given
+ * direction by a safe amount.
+ *
+ * Let first_bad and last_bad be the first and last unsafe steps (step i goes
+ * from level i to level i + 1). Removing level j only changes steps j - 1
+ * and j, so it can only help if j is first_bad or first_bad + 1; it works if
+ * the levels before j are safe (true, j >= first_bad), the levels after j are
+ * safe (last_bad <= j), and the step bridging the gap, j - 1 to j + 1, is
+ * safe. That is two linear scans with no copies.
+ */
+[[gnu::pure]] auto
+report_is_safe_skipping_one(const std::span<const int> report,
+                            const std::span<const uint8_t> steps,
+                            const uint8_t direction) -> bool {
+    const std::size_t num_steps = steps.size();
+    std::size_t first_bad = 0;
+    while(first_bad < num_steps && (steps[first_bad] & direction) != 0) {
+        ++first_bad;
+    }
+    if(first_bad == num_steps) {
+        return true;
+    }
+    std::size_t last_bad = num_steps - 1;
+    while((steps[last_bad] & direction) != 0) {
+        --last_bad;
+    }
 
-        if(!(initial_increasing == currently_increasing &&
-             INCREASE_LOWER_BOUND <= std::abs(diff) &&
-             std::abs(diff) <= INCREASE_UPPER_BOUND)) {
-            return false;
+    for(const std::size_t skipped : {first_bad, first_bad + 1}) {
+        if(last_bad > skipped) {
+            continue;
+        }
+        if(skipped == 0 || skipped == num_steps ||
+           step_is_safe(report[skipped - 1], report[skipped + 1],
+                        direction == SAFE_INCREASING)) {
+            return true;
         }
     }
 
-    return true;
+    return false;
 }
 
 /**
@@ -56,75 +182,138 @@ auto report_is_safe(const std::vector<int> &report) -> bool {
  * [7, 6, 7, 8] - remove first 7
  *
  */
-auto report_is_safe_with_problem_dampener(std::vector<int> report) -> bool {
-    if(report.size() < 2) {
+[[gnu::pure]] auto
+report_is_safe_with_problem_dampener(const std::span<const int> report,
+                                     const std::span<const uint8_t> steps)
+    -> bool {
+    if(report.size() < 3) {
         return true;
     }
 
-    const bool initial_increasing = (report[1] > report[0]);
-    for(std::size_t i = 0; i + 1 < report.size(); ++i) {
-        const int diff = report[i + 1] - report[i];
-        const bool currently_increasing = (diff > 0);
-
-        if(!(initial_increasing == currently_increasing &&
-             INCREASE_LOWER_BOUND <= std::abs(diff) &&
-             std::abs(diff) <= INCREASE_UPPER_BOUND)) {
-
-            auto pos_to_delete = report.begin();
-            // try removing element i - 1
-            if(i > 0) {
-                const int level_i_1 = report[i - 1];
-                std::advance(pos_to_delete, i - 1);
-                report.erase(pos_to_delete);
-                if(report_is_safe(report)) {
-                    return true;
-                }
-                report.insert(pos_to_delete, level_i_1);
-            }
+    return report_is_safe_skipping_one(report, steps, SAFE_INCREASING) ||
+           report_is_safe_skipping_one(report, steps, SAFE_DECREASING);
+}
 
-            // try removing element i
-            const int level_i = report[i];
-            pos_to_delete = report.begin();
-            std::advance(pos_to_delete, i);
-            report.erase(pos_to_delete);
+/**
+ * Whether deleting at most max_removals levels leaves every step moving in
+ * the given direction by a safe amount, in O(n * max_removals).
+ *
+ * fewest_removals[i] is the fewest deletions among levels 0 .. i that leave
+ * a safe run ending with level i kept. The level kept before i lies at most
+ * max_removals + 1 back, so only those predecessors are tried, and only that
+ * window of the table is kept, in a ring buffer.
+ */
+auto report_is_safe_removing_up_to(const std::span<const int> report,
+                                   const std::size_t max_removals,
+                                   const bool increasing) -> bool {
+    const std::size_t num_levels = report.size();
+    if(num_levels <= max_removals + 1) {
+        return true;
+    }
 
-            if(report_is_safe(report)) {
-                return true;
+    const std::size_t window = max_removals + 2;
+    std::vector<std::size_t> fewest_removals(window, 0);
+    for(std::size_t i = 0; i < num_levels; ++i) {
+        std::size_t best = i; // everything before i deleted
+        const std::size_t earliest =
+            (i > max_removals + 1) ? i - max_removals - 1 : 0;
+        for(std::size_t j = earliest; j < i; ++j) {
+            if(step_is_safe(report[j], report[i], increasing)) {
+                best = std::min(best, fewest_removals[j % window] + i - j - 1);
             }
-
-            // try removing element i + 1
-            report.insert(pos_to_delete, level_i);
-            pos_to_delete = report.begin();
-            std::advance(pos_to_delete, i + 1);
-            report.erase(pos_to_delete);
-
-            return report_is_safe(report);
+        }
+        fewest_removals[i % window] = best;
+        if(best + (num_levels - 1 - i) <= max_removals) {
+            return true;
         }
     }
 
-    return true;
+    return false;
 }
 
-auto solve_day02a() -> int64_t {
-    const std::vector<std::vector<int>> reports = parse_input();
-    int64_t count = 0;
-    for(const std::vector<int> &report : reports) {
-        if(report_is_safe(report)) {
-            ++count;
-        }
+/**
+ * steps are the classified steps of report. No removals and one removal
+ * (the puzzle's problem dampener) have dedicated linear checks; more go
+ * through the dynamic program.
+ */
+auto report_is_safe_with_removals(const std::span<const int> report,
+                                  const std::span<const uint8_t> steps,
+                                  const std::size_t max_removals) -> bool {
+    if(max_removals == 0) {
+        return report_is_safe(steps);
     }
+    if(max_removals == 1) {
+        return report_is_safe_with_problem_dampener(report, steps);
+    }
+
+    return report_is_safe_removing_up_to(report, max_removals, true) ||
+           report_is_safe_removing_up_to(report, max_removals, false);
+}
 
-    return count;
+auto report_is_safe_with_removals(const std::span<const int> report,
+                                  const std::size_t max_removals) -> bool {
+    std::vector<uint8_t> step_flags;
+    classify_steps(report, step_flags);
+    return report_is_safe_with_removals(report, step_flags, max_removals);
 }
 
-auto solve_day02b() -> int64_t {
-    const std::vector<std::vector<int>> reports = parse_input();
-    int64_t count = 0;
-    for(const std::vector<int> &report : reports) {
-        if(report_is_safe_with_problem_dampener(report)) {
-            ++count;
+/**
+ * Number of safe reports. Large inputs are split into runs of consecutive
+ * reports, each classified and counted on its own thread.
+ */
+auto count_safe_reports(const Reports &reports,
+                        const std::size_t max_removals) -> int64_t {
+    constexpr const std::size_t MIN_LEVELS_PER_THREAD = std::size_t{1} << 16U;
+
+    const std::size_t max_threads =
+        std::max(1U, std::thread::hardware_concurrency());
+    const std::size_t num_chunks = std::clamp<std::size_t>(
+        reports.levels.size() / MIN_LEVELS_PER_THREAD, 1, max_threads);
+
+    std::vector<int64_t> counts(num_chunks, 0);
+    const auto count_chunk = [&reports, max_removals, num_chunks,
+                              &counts](const std::size_t chunk) {
+        const std::size_t first = reports.size() * chunk / num_chunks;
+        const std::size_t last = reports.size() * (chunk + 1) / num_chunks;
+        const std::size_t base = reports.offsets[first];
+        const std::span<const int> levels(reports.levels.data() + base,
+                                          reports.offsets[last] - base);
+        std::vector<uint8_t> step_flags;
+        classify_steps(levels, step_flags);
+
+        int64_t count = 0;
+        for(std::size_t r = first; r < last; ++r) {
+            const std::size_t begin = reports.offsets[r] - base;
+            const std::size_t end = reports.offsets[r + 1] - base;
+            const std::size_t size = end - begin;
+            const std::span<const int> report = levels.subspan(begin, size);
+            const std::span<const uint8_t> steps =
+                (size < 2) ? std::span<const uint8_t>{}
+                           : std::span<const uint8_t>(step_flags)
+                                 .subspan(begin, size - 1);
+            if(report_is_safe_with_removals(report, steps, max_removals)) {
+                ++count;
+            }
         }
+        counts[chunk] = count;
+    };
+
+    std::vector<std::thread> workers;
+    for(std::size_t chunk = 1; chunk < num_chunks; ++chunk) {
+        workers.emplace_back(count_chunk, chunk);
+    }
+    count_chunk(0);
+    for(std::thread &worker : workers) {
+        worker.join();
     }
 
-    return count;
+    return std::accumulate(counts.begin(), counts.end(), int64_t{0});
 }
+
+auto count_day02_safe_reports(const std::size_t max_removals) -> int64_t {
+    return count_safe_reports(parse_input(), max_removals);
+}
+
+auto solve_day02a() -> int64_t { return count_day02_safe_reports(0); }
+
+auto solve_day02b() -> int64_t { return count_day02_safe_reports(1); }
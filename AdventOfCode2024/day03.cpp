@@ -1,65 +1,309 @@
-#include <fstream>
-#include <regex>
+#include <algorithm> // std::clamp, std::max, std::min
+#include <cstddef>
+#include <cstdint>
+#include <cstring>    // std::memchr
+#include <functional> // std::ref
+#include <future>
+#include <istream>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <utility> // std::pair, std::swap
+#include <vector>
 
 #include "day.hpp"
+#include "utils.hpp"
 
-static auto parse_input() -> std::string {
-    const std::string input_file_name{"data/day03.txt"};
-    std::ifstream input_file{input_file_name};
+/**
+ * Finds the instructions "mul(a,b)", "do()" and "don't()" in corrupted
+ * memory, where a and b are runs of one to three decimal digits, and sums the
+ * products. Matches are the same as searching left to right for the regex
+ * mul\((\d{1,3}),(\d{1,3})\)|do\(\)|don't\(\) with newlines removed first:
+ * newlines are skipped wherever they appear.
+ *
+ * It is a deterministic state machine fed one byte at a time. No proper
+ * prefix of an instruction contains an 'm' or a 'd' after its first byte, so
+ * when a byte does not fit the instruction being read, no instruction can
+ * have started since; the machine returns to READY and reconsiders that same
+ * byte. In READY, memchr skips straight to the next 'm' or 'd'.
+ *
+ * The scanner does not need to know whether multiplications are enabled when
+ * it starts: products seen before the first "do()" or "don't()" are summed
+ * separately, and the getters take the initial state. That lets pieces of
+ * one memory be scanned independently and combined afterwards.
+ */
+class MemoryScanner {
+  public:
+    /**
+     * Scan the instructions that start in memory[begin, end). An
+     * instruction that starts before end is followed past it, so that
+     * scanning adjacent ranges with separate scanners sees every
+     * instruction exactly once: the bytes of an instruction after its first
+     * one are never an 'm' or a 'd', so a scanner starting in READY inside
+     * one skips it.
+     */
+    auto scan(const std::string_view memory, const std::size_t begin,
+              const std::size_t end) -> void {
+        const char *data = memory.data();
+        const std::size_t size = memory.size();
+        const auto find_from = [data, end](const char wanted,
+                                           const std::size_t from) {
+            const void *found = std::memchr(data + from, wanted, end - from);
+            return (found == nullptr)
+                       ? end
+                       : static_cast<std::size_t>(
+                             static_cast<const char *>(found) - data);
+        };
+        std::size_t next_m = find_from('m', begin);
+        std::size_t next_d = find_from('d', begin);
 
-    std::string input;
-    std::string line;
-    while(std::getline(input_file, line)) {
-        input += line;
+        std::size_t i = begin;
+        while(i < size) {
+            if(state == State::READY) {
+                if(i >= end) {
+                    break;
+                }
+                if(next_m < i) {
+                    next_m = find_from('m', i);
+                }
+                if(next_d < i) {
+                    next_d = find_from('d', i);
+                }
+                i = std::min(next_m, next_d);
+                if(i == end) {
+                    break;
+                }
+            }
+            if(data[i] == '\n' || advance(data[i])) {
+                ++i;
+            } else {
+                state = State::READY;
+            }
+        }
     }
 
-    return input;
-}
+    /**
+     * Sum of every multiplication, and of those not disabled by a preceding
+     * "don't()" given whether they were enabled before the scanned memory.
+     */
+    [[nodiscard]] auto get_sum_of_all() const -> int64_t { return sum_of_all; }
+    [[nodiscard]] auto get_sum_of_enabled(const bool initially_enabled) const
+        -> int64_t {
+        return (initially_enabled ? sum_before_first_toggle : 0) +
+               sum_of_enabled;
+    }
+    [[nodiscard]] auto is_enabled_after(const bool initially_enabled) const
+        -> bool {
+        return enabled.value_or(initially_enabled);
+    }
 
-auto solve_day03a() -> int64_t {
-    // see https://en.cppreference.com/w/cpp/regex
-    const std::regex mul_pattern(R"(mul\((\d+),(\d+)\))");
-    int64_t sum = 0;
-
-    const std::string memory = parse_input();
-    auto mul_start =
-        std::sregex_iterator(memory.begin(), memory.end(), mul_pattern);
-    auto mul_end = std::sregex_iterator();
-
-    for(std::sregex_iterator i = mul_start; i != mul_end; ++i) {
-        std::smatch match = *i;
-        const int left = std::stoi(match[1]);
-        const int right = std::stoi(match[2]);
-        sum += left * right;
+  private:
+    enum class State {
+        READY,
+        M,
+        MU,
+        MUL,
+        LEFT_FIRST_DIGIT,
+        LEFT_DIGITS,
+        RIGHT_FIRST_DIGIT,
+        RIGHT_DIGITS,
+        D,
+        DO,
+        DO_OPEN,
+        DON,
+        DON_APOSTROPHE,
+        DONT,
+        DONT_OPEN
+    };
+
+    /**
+     * Consume c if it continues the current instruction (or, in READY, in
+     * any case); false if the machine has to restart at c.
+     */
+    auto advance(const char c) -> bool {
+        const bool is_digit = ('0' <= c && c <= '9');
+        switch(state) {
+        case State::READY:
+            state = (c == 'm') ? State::M
+                    : (c == 'd') ? State::D
+                                 : State::READY;
+            return true;
+        case State::M:
+            return expect(c, 'u', State::MU);
+        case State::MU:
+            return expect(c, 'l', State::MUL);
+        case State::MUL:
+            left = 0;
+            right = 0;
+            num_digits = 0;
+            return expect(c, '(', State::LEFT_FIRST_DIGIT);
+        case State::LEFT_FIRST_DIGIT:
+        case State::LEFT_DIGITS:
+            if(is_digit) {
+                if(num_digits == MAX_OPERAND_DIGITS) {
+                    return false;
+                }
+                left = 10 * left + (c - '0');
+                ++num_digits;
+                state = State::LEFT_DIGITS;
+                return true;
+            }
+            num_digits = 0;
+            return state == State::LEFT_DIGITS &&
+                   expect(c, ',', State::RIGHT_FIRST_DIGIT);
+        case State::RIGHT_FIRST_DIGIT:
+        case State::RIGHT_DIGITS:
+            if(is_digit) {
+                if(num_digits == MAX_OPERAND_DIGITS) {
+                    return false;
+                }
+                right = 10 * right + (c - '0');
+                ++num_digits;
+                state = State::RIGHT_DIGITS;
+                return true;
+            }
+            if(state == State::RIGHT_DIGITS && c == ')') {
+                sum_of_all += left * right;
+                if(!enabled.has_value()) {
+                    sum_before_first_toggle += left * right;
+                } else if(*enabled) {
+                    sum_of_enabled += left * right;
+                }
+                state = State::READY;
+                return true;
+            }
+            return false;
+        case State::D:
+            return expect(c, 'o', State::DO);
+        case State::DO:
+            return expect(c, '(', State::DO_OPEN) ||
+                   expect(c, 'n', State::DON);
+        case State::DO_OPEN:
+            if(c == ')') {
+                enabled = true;
+            }
+            return expect(c, ')', State::READY);
+        case State::DON:
+            return expect(c, '\'', State::DON_APOSTROPHE);
+        case State::DON_APOSTROPHE:
+            return expect(c, 't', State::DONT);
+        case State::DONT:
+            return expect(c, '(', State::DONT_OPEN);
+        case State::DONT_OPEN:
+            if(c == ')') {
+                enabled = false;
+            }
+            return expect(c, ')', State::READY);
+        default:
+            return false;
+        }
     }
-    return sum;
-}
 
-auto solve_day03b() -> int64_t {
-    // see https://en.cppreference.com/w/cpp/regex
-    const std::regex mul_pattern(R"(mul\((\d+),(\d+)\)|do\(\)|don't\(\))");
-    int64_t sum = 0;
+    auto expect(const char c, const char wanted, const State next) -> bool {
+        if(c != wanted) {
+            return false;
+        }
+        state = next;
+        return true;
+    }
+
+    // longer operands are not instructions, which also bounds the products
+    static constexpr int MAX_OPERAND_DIGITS = 3;
+
+    State state = State::READY;
+    // unknown until the first "do()" or "don't()"
+    std::optional<bool> enabled{};
+    int64_t left = 0;
+    int64_t right = 0;
+    // digits of the operand being read
+    int num_digits = 0;
+    int64_t sum_of_all = 0;
+    int64_t sum_before_first_toggle = 0;
+    int64_t sum_of_enabled = 0;
+};
+
+/**
+ * Both parts' sums over memory, split into chunks scanned in parallel. Every
+ * chunk is scanned once without knowing whether it starts enabled; walking
+ * the chunks in order then carries the enabled state from each chunk into
+ * the next and picks the matching partial sum.
+ */
+auto scan_day03_memory(const std::string_view memory,
+                       const std::size_t num_threads)
+    -> std::pair<int64_t, int64_t> {
+    const std::size_t num_chunks =
+        std::clamp<std::size_t>(num_threads, 1, std::max<std::size_t>(
+                                                    1, memory.size()));
+
+    std::vector<MemoryScanner> scanners(num_chunks);
+    const auto scan_chunk = [&memory, num_chunks,
+                             &scanners](const std::size_t chunk) {
+        scanners[chunk].scan(memory, memory.size() * chunk / num_chunks,
+                             memory.size() * (chunk + 1) / num_chunks);
+    };
+    std::vector<std::thread> workers;
+    for(std::size_t chunk = 1; chunk < num_chunks; ++chunk) {
+        workers.emplace_back(scan_chunk, chunk);
+    }
+    scan_chunk(0);
+    for(std::thread &worker : workers) {
+        worker.join();
+    }
+
+    int64_t sum_of_all = 0;
+    int64_t sum_of_enabled = 0;
     bool enabled = true;
+    for(const MemoryScanner &scanner : scanners) {
+        sum_of_all += scanner.get_sum_of_all();
+        sum_of_enabled += scanner.get_sum_of_enabled(enabled);
+        enabled = scanner.is_enabled_after(enabled);
+    }
 
-    const std::string memory = parse_input();
-    auto mul_start =
-        std::sregex_iterator(memory.begin(), memory.end(), mul_pattern);
-    auto mul_end = std::sregex_iterator();
+    return {sum_of_all, sum_of_enabled};
+}
 
-    for(std::sregex_iterator i = mul_start; i != mul_end; ++i) {
-        std::smatch match = *i;
+/**
+ * Both parts' sums over a feed read buffer_bytes at a time, so memory use
+ * does not depend on the feed's length. A scanner keeps its state between
+ * calls, so instructions split across buffers need no special handling. The
+ * next buffer is read on another thread while the current one is scanned.
+ */
+auto stream_day03_memory(std::istream &feed, const std::size_t buffer_bytes)
+    -> std::pair<int64_t, int64_t> {
+    // an empty buffer marks the end of the feed, so never ask for 0 bytes
+    const std::size_t read_bytes = std::max(buffer_bytes, std::size_t{1});
+    const auto fill = [&feed, read_bytes](std::vector<char> &buffer) {
+        buffer.resize(read_bytes);
+        feed.read(buffer.data(), static_cast<std::streamsize>(read_bytes));
+        buffer.resize(static_cast<std::size_t>(feed.gcount()));
+    };
 
-        if(match[0] == "do()") {
-            enabled = true;
-        } else if(match[0] == "don't()") {
-            enabled = false;
-        }
-        if(match.str().substr(0, 3) == "mul" && enabled) {
-            const int left = std::stoi(match[1]);
-            const int right = std::stoi(match[2]);
-            sum += left * right;
-        }
+    std::vector<char> current;
+    std::vector<char> next;
+    fill(current);
+    MemoryScanner scanner;
+    while(!current.empty()) {
+        std::future<void> reading =
+            std::async(std::launch::async, fill, std::ref(next));
+        scanner.scan({current.data(), current.size()}, 0, current.size());
+        reading.get();
+        std::swap(current, next);
     }
-    return sum;
+
+    return {scanner.get_sum_of_all(), scanner.get_sum_of_enabled(true)};
+}
+
+static auto scan_input() -> std::pair<int64_t, int64_t> {
+    constexpr const std::size_t MIN_BYTES_PER_THREAD = std::size_t{1} << 20U;
+
+    const std::string memory = read_input("data/day03.txt");
+    const std::size_t num_threads = std::min<std::size_t>(
+        memory.size() / MIN_BYTES_PER_THREAD + 1,
+        std::max(1U, std::thread::hardware_concurrency()));
+    return scan_day03_memory(memory, num_threads);
 }
+
+auto solve_day03a() -> int64_t { return scan_input().first; }
+
+auto solve_day03b() -> int64_t { return scan_input().second; }
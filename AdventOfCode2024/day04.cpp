@@ -1,37 +1,82 @@
+#include <algorithm> // std::clamp, std::max, std::min
 #include <cstddef>
-#include <fstream>
+#include <cstdint>
+#include <sstream>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <utility> // std::pair
 #include <vector>
 
+#include "aho_corasick.hpp"
+#include "bit_grid.hpp"
 #include "day.hpp"
+#include "utils.hpp"
 
-auto is_valid_position(const std::vector<std::string> &grid, const int row,
-                       const int col) -> bool {
-    return 0 <= row && std::size_t(row) < grid.size() && 0 <= col &&
-           std::size_t(col) < grid[std::size_t(row)].size();
-}
-
-auto word_exists_at_position_in_direction(const std::vector<std::string> &grid,
-                                          const std::string &pattern,
-                                          const int starting_row,
-                                          const int starting_col, const int dx,
-                                          const int dy) -> bool {
-    for(int i = 0; std::size_t(i) < pattern.size(); ++i) {
-        const int row = starting_row + i * dx;
-        const int col = starting_col + i * dy;
-        if(!is_valid_position(grid, row, col) ||
-           grid[std::size_t(row)][std::size_t(col)] !=
-               pattern[std::size_t(i)]) {
-            return false;
+/**
+ * The grid as one bit plane per letter of interest: plane(letter) has a bit
+ * set wherever the grid holds that letter. A word read in some direction
+ * then starts at every cell of an AND of shifted planes, worked out 64 cells
+ * at a time with no bounds checks: cells shifted in from outside the grid
+ * are zero.
+ */
+class LetterPlanes {
+  public:
+    LetterPlanes(const std::vector<std::string> &grid,
+                 const std::string &letters_)
+        : letters(letters_) {
+        std::size_t num_cols = 0;
+        for(const std::string &row : grid) {
+            num_cols = std::max(num_cols, row.size());
+        }
+        planes.assign(letters.size(), BitGrid(grid.size(), num_cols));
+        for(std::size_t row = 0; row < grid.size(); ++row) {
+            for(std::size_t col = 0; col < grid[row].size(); ++col) {
+                const std::size_t index = letters.find(grid[row][col]);
+                if(index != std::string::npos) {
+                    planes[index].set(row, col);
+                }
+            }
         }
     }
 
-    return true;
-}
+    LetterPlanes(const LetterPlanes &other);
+    LetterPlanes(LetterPlanes &&other) noexcept;
+    auto operator=(const LetterPlanes &other) -> LetterPlanes &;
+    auto operator=(LetterPlanes &&other) noexcept -> LetterPlanes &;
+    ~LetterPlanes();
+
+    /**
+     * Cells (row, col) whose neighbor (row + row_offset, col + col_offset)
+     * holds letter.
+     */
+    [[nodiscard]] auto neighbors_holding(const char letter,
+                                         const int row_offset,
+                                         const int col_offset) const
+        -> BitGrid {
+        const BitGrid &plane = planes[letters.find(letter)];
+        BitGrid shifted(plane.num_rows(), plane.num_cols());
+        shifted.or_shifted(plane, -row_offset, -col_offset);
+        return shifted;
+    }
+
+  private:
+    std::string letters;
+    std::vector<BitGrid> planes{};
+};
+
+// out of line, so -Winline has no inline destructor to give up on
+LetterPlanes::LetterPlanes(const LetterPlanes &other) = default;
+LetterPlanes::LetterPlanes(LetterPlanes &&other) noexcept = default;
+auto LetterPlanes::operator=(const LetterPlanes &other)
+    -> LetterPlanes & = default;
+auto LetterPlanes::operator=(LetterPlanes &&other) noexcept
+    -> LetterPlanes & = default;
+LetterPlanes::~LetterPlanes() = default;
 
 static auto parse_input() -> std::vector<std::string> {
     const std::string input_file_name{"data/day04.txt"};
-    std::ifstream input_file{input_file_name};
+    std::istringstream input_file = open_input(input_file_name);
 
     std::vector<std::string> input;
     std::string line;
@@ -42,66 +87,230 @@ static auto parse_input() -> std::vector<std::string> {
     return input;
 }
 
-auto solve_day04a() -> int64_t {
-    const std::vector<std::string> grid = parse_input();
-    const std::string search_word = "XMAS";
+/**
+ * Occurrences of word reading in any of the eight directions. planes must
+ * cover every letter of word.
+ */
+auto count_word_occurrences(const LetterPlanes &planes, const std::string &word)
+    -> int64_t {
     int64_t count = 0;
-    for(int i = 0; std::size_t(i) < grid.size(); ++i) {
-        for(int j = 0; std::size_t(j) < grid[std::size_t(i)].size(); ++j) {
-            for(int dx = -1; dx <= 1; ++dx) {
-                for(int dy = -1; dy <= 1; ++dy) {
-                    if(dx == 0 && dy == 0) {
+    for(int dx = -1; dx <= 1; ++dx) {
+        for(int dy = -1; dy <= 1; ++dy) {
+            if(dx == 0 && dy == 0) {
+                continue;
+            }
+
+            BitGrid starts = planes.neighbors_holding(word[0], 0, 0);
+            for(std::size_t i = 1; i + 1 < word.size(); ++i) {
+                const int distance = static_cast<int>(i);
+                starts &= planes.neighbors_holding(word[i], distance * dx,
+                                                   distance * dy);
+            }
+            if(word.size() > 1) {
+                const int distance = static_cast<int>(word.size() - 1);
+                count += static_cast<int64_t>(
+                    starts.count_and(planes.neighbors_holding(
+                        word.back(), distance * dx, distance * dy)));
+            } else {
+                count += static_cast<int64_t>(starts.count());
+            }
+        }
+    }
+
+    return count;
+}
+
+/**
+ * Occurrences of each word reading in any of the eight directions, found by
+ * running every line of the grid (rows, columns and both diagonal families,
+ * each forwards and backwards) through one Aho-Corasick automaton. The grid
+ * is read as rectangular, with the width of its first row: shorter rows are
+ * padded with spaces and longer ones cut off.
+ */
+auto count_words_in_grid(const std::vector<std::string> &grid,
+                         const std::vector<std::string> &words)
+    -> std::vector<int64_t> {
+    const AhoCorasick automaton(words);
+    std::vector<int64_t> visits(automaton.num_states(), 0);
+
+    const auto num_rows = static_cast<int>(grid.size());
+    const auto num_cols = static_cast<int>(grid.empty() ? 0 : grid[0].size());
+    const auto in_grid = [num_rows, num_cols](const int row, const int col) {
+        return 0 <= row && row < num_rows && 0 <= col && col < num_cols;
+    };
+
+    for(int dx = -1; dx <= 1; ++dx) {
+        for(int dy = -1; dy <= 1; ++dy) {
+            if(dx == 0 && dy == 0) {
+                continue;
+            }
+
+            // a line in this direction starts at every cell whose
+            // predecessor is off the grid
+            for(int row = 0; row < num_rows; ++row) {
+                for(int col = 0; col < num_cols; ++col) {
+                    if(in_grid(row - dx, col - dy)) {
                         continue;
                     }
-
-                    if(word_exists_at_position_in_direction(grid, search_word,
-                                                            i, j, dx, dy)) {
-                        ++count;
+                    std::size_t state = AhoCorasick::START_STATE;
+                    for(int r = row, c = col; in_grid(r, c);
+                        r += dx, c += dy) {
+                        const std::string &line =
+                            grid[static_cast<std::size_t>(r)];
+                        const auto col_index = static_cast<std::size_t>(c);
+                        state = automaton.step(
+                            state,
+                            col_index < line.size() ? line[col_index] : ' ');
+                        ++visits[state];
                     }
                 }
             }
         }
     }
 
-    return count;
+    return automaton.occurrences_per_word(visits);
+}
+
+auto count_day04_words(const std::vector<std::string> &words)
+    -> std::vector<int64_t> {
+    return count_words_in_grid(parse_input(), words);
 }
 
-auto forms_double_mas(const std::vector<std::string> &grid,
-                      const std::size_t starting_row,
-                      const std::size_t starting_col) -> bool {
-    if(grid[starting_row][starting_col] != 'A') {
-        return false;
+auto solve_day04a() -> int64_t {
+    const std::string search_word = "XMAS";
+    const LetterPlanes planes(parse_input(), search_word);
+    return count_word_occurrences(planes, search_word);
+}
+
+/**
+ * An 'A' whose two diagonals each read "MAS" one way or the other.
+ */
+auto count_double_mas(const LetterPlanes &planes) -> int64_t {
+    const auto diagonal_reads_mas = [&planes](const int col_offset) {
+        BitGrid m_then_s = planes.neighbors_holding('M', -1, -col_offset);
+        m_then_s &= planes.neighbors_holding('S', 1, col_offset);
+        BitGrid s_then_m = planes.neighbors_holding('S', -1, -col_offset);
+        s_then_m &= planes.neighbors_holding('M', 1, col_offset);
+        m_then_s |= s_then_m;
+        return m_then_s;
+    };
+
+    BitGrid centers = planes.neighbors_holding('A', 0, 0);
+    centers &= diagonal_reads_mas(1);
+    return static_cast<int64_t>(centers.count_and(diagonal_reads_mas(-1)));
+}
+
+auto solve_day04b() -> int64_t {
+    const LetterPlanes planes(parse_input(), "MAS");
+    return count_double_mas(planes);
+}
+
+/**
+ * A grid in one contiguous buffer, row after row without the newlines. Rows
+ * shorter than the first are padded with spaces.
+ */
+struct LetterGrid {
+    std::string cells{};
+    std::size_t num_rows = 0;
+    std::size_t num_cols = 0;
+
+    [[nodiscard]] auto at(const std::size_t row, const std::size_t col) const
+        -> char {
+        return cells[row * num_cols + col];
     }
+};
 
-    // all corners comprised of 2 M and 2 S
-    unsigned int num_m = 0;
-    unsigned int num_s = 0;
-    const char corner1 = grid[starting_row - 1][starting_col - 1];
-    const char corner2 = grid[starting_row - 1][starting_col + 1];
-    const char corner3 = grid[starting_row + 1][starting_col - 1];
-    const char corner4 = grid[starting_row + 1][starting_col + 1];
-    const std::vector<char> corner_letters{corner1, corner2, corner3, corner4};
-    for(const char corner : corner_letters) {
-        if(corner == 'M') {
-            num_m++;
-        } else if(corner == 'S') {
-            num_s++;
-        }
+auto load_letter_grid(const std::string_view text) -> LetterGrid {
+    LetterGrid grid;
+    grid.num_cols = std::min(text.find('\n'), text.size());
+    for(std::size_t line_start = 0; line_start < text.size();) {
+        const std::size_t line_end =
+            std::min(text.find('\n', line_start), text.size());
+        const std::string_view line =
+            text.substr(line_start, std::min(line_end - line_start,
+                                             grid.num_cols));
+        grid.cells.append(line);
+        grid.cells.append(grid.num_cols - line.size(), ' ');
+        ++grid.num_rows;
+        line_start = line_end + 1;
     }
 
-    if(!(num_m == 2 && num_s == 2)) {
-        return false;
+    return grid;
+}
+
+/**
+ * Occurrences of word, in any of the eight directions, that start in rows
+ * [first_row, last_row). Letters up to word.size() - 1 rows above and below
+ * the band (its halo) are read in place, and a match is only counted by the
+ * band holding its first letter, so adjacent bands never count one twice.
+ */
+[[gnu::pure]] auto count_word_in_band(const LetterGrid &grid,
+                                      const std::string &word,
+                                      const std::size_t first_row,
+                                      const std::size_t last_row) -> int64_t {
+    const auto reach = static_cast<int64_t>(word.size()) - 1;
+    const auto num_rows = static_cast<int64_t>(grid.num_rows);
+    const auto num_cols = static_cast<int64_t>(grid.num_cols);
+
+    int64_t count = 0;
+    for(auto row = static_cast<int64_t>(first_row);
+        row < static_cast<int64_t>(last_row); ++row) {
+        const char *row_start =
+            grid.cells.data() + static_cast<std::size_t>(row * num_cols);
+        for(int64_t col = 0; col < num_cols; ++col) {
+            if(row_start[col] != word[0]) {
+                continue;
+            }
+            for(int64_t dx = -1; dx <= 1; ++dx) {
+                const int64_t end_row = row + reach * dx;
+                if(end_row < 0 || end_row >= num_rows) {
+                    continue;
+                }
+                for(int64_t dy = -1; dy <= 1; ++dy) {
+                    const int64_t end_col = col + reach * dy;
+                    if((dx == 0 && dy == 0) || end_col < 0 ||
+                       end_col >= num_cols) {
+                        continue;
+                    }
+                    // consecutive letters are a fixed distance apart in the
+                    // buffer
+                    const int64_t stride = dx * num_cols + dy;
+                    const char *letter = row_start + col;
+                    std::size_t i = 1;
+                    while(i < word.size() && *(letter += stride) == word[i]) {
+                        ++i;
+                    }
+                    if(i == word.size()) {
+                        ++count;
+                    }
+                }
+            }
+        }
     }
 
-    return corner1 != corner4;
+    return count;
 }
 
-auto solve_day04b() -> int64_t {
-    const std::vector<std::string> grid = parse_input();
+/**
+ * X-MAS crosses centered in rows [first_row, last_row); the halo is one row.
+ */
+[[gnu::pure]] auto count_double_mas_in_band(const LetterGrid &grid,
+                                            const std::size_t first_row,
+                                            const std::size_t last_row)
+    -> int64_t {
+    const auto reads_mas = [](const char first, const char last) {
+        return (first == 'M' && last == 'S') || (first == 'S' && last == 'M');
+    };
+
     int64_t count = 0;
-    for(std::size_t i = 1; i + 1 < grid.size(); ++i) {
-        for(std::size_t j = 1; j + 1 < grid[i].size(); ++j) {
-            if(forms_double_mas(grid, i, j)) {
+    for(std::size_t row = std::max<std::size_t>(first_row, 1);
+        row < std::min(last_row, grid.num_rows - 1); ++row) {
+        for(std::size_t col = 1; col + 1 < grid.num_cols; ++col) {
+            if(grid.at(row, col) == 'A' &&
+               reads_mas(grid.at(row - 1, col - 1),
+                         grid.at(row + 1, col + 1)) &&
+               reads_mas(grid.at(row - 1, col + 1),
+                         grid.at(row + 1, col - 1))) {
                 ++count;
             }
         }
@@ -109,3 +318,37 @@ auto solve_day04b() -> int64_t {
 
     return count;
 }
+
+auto scan_day04_grid(const std::string_view text,
+                     const std::size_t num_threads)
+    -> std::pair<int64_t, int64_t> {
+    const LetterGrid grid = load_letter_grid(text);
+    const std::size_t num_bands =
+        std::clamp<std::size_t>(num_threads, 1, std::max<std::size_t>(
+                                                    1, grid.num_rows));
+
+    std::vector<std::pair<int64_t, int64_t>> band_counts(num_bands);
+    const auto scan_band = [&grid, num_bands,
+                            &band_counts](const std::size_t band) {
+        const std::size_t first_row = grid.num_rows * band / num_bands;
+        const std::size_t last_row = grid.num_rows * (band + 1) / num_bands;
+        band_counts[band] = {
+            count_word_in_band(grid, "XMAS", first_row, last_row),
+            count_double_mas_in_band(grid, first_row, last_row)};
+    };
+    std::vector<std::thread> workers;
+    for(std::size_t band = 1; band < num_bands; ++band) {
+        workers.emplace_back(scan_band, band);
+    }
+    scan_band(0);
+    for(std::thread &worker : workers) {
+        worker.join();
+    }
+
+    std::pair<int64_t, int64_t> totals{0, 0};
+    for(const auto &[xmas_count, double_mas_count] : band_counts) {
+        totals.first += xmas_count;
+        totals.second += double_mas_count;
+    }
+    return totals;
+}
@@ -1,60 +1,339 @@
 #include <algorithm>
+#include <bit> // std::popcount
 #include <cstddef>
-#include <fstream>
-#include <map>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <span>
+#include <sstream>
 #include <string>
-#include <unordered_set>
-#include <utility>
+#include <utility> // std::move, std::pair
 #include <vector>
 
+#include "bit_grid.hpp"
 #include "day.hpp"
+#include "graph.hpp"
 #include "utils.hpp"
 
-static auto parse_input() -> std::pair<std::map<int, std::unordered_set<int>>,
-                                       std::vector<std::vector<int>>> {
-    const std::string input_file_name{"data/day05.txt"};
-    std::ifstream input_file{input_file_name};
+// by default, rule sets over at most this many pages also get a dense rule
+// matrix
+constexpr const std::size_t DEFAULT_MAX_DENSE_RULE_PAGES = 4096;
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+static std::size_t max_dense_rule_pages = DEFAULT_MAX_DENSE_RULE_PAGES;
+
+auto set_day05_max_dense_rule_pages(const std::size_t max_pages) -> void {
+    max_dense_rule_pages = max_pages;
+}
+
+struct PrintQueue {
+    PrintQueue(Interner<int> pages_, CsrGraph rules_,
+               std::optional<BitGrid> rule_matrix_, bool rules_consistent_,
+               std::optional<std::vector<std::size_t>> page_ranks_,
+               std::vector<std::vector<std::size_t>> manuals_);
+    // out of line, so -Winline does not flag them on cold paths
+    PrintQueue(const PrintQueue &other);
+    PrintQueue(PrintQueue &&other) noexcept;
+    auto operator=(const PrintQueue &other) -> PrintQueue &;
+    auto operator=(PrintQueue &&other) noexcept -> PrintQueue &;
+    ~PrintQueue();
+
+    // page numbers, interned to the dense node ids used below
+    Interner<int> pages;
+    // edge a -> b: page a must be printed before page b
+    CsrGraph rules;
+    // the same rules as a bit matrix, row a holding every page that must
+    // come after page a; only for small rule sets
+    std::optional<BitGrid> rule_matrix;
+    // no two rules order the same pair of pages both ways
+    bool rules_consistent;
+    // a rank per page in use, if the rules order every pair of them
+    std::optional<std::vector<std::size_t>> page_ranks;
+    std::vector<std::vector<std::size_t>> manuals;
+};
+
+PrintQueue::PrintQueue(Interner<int> pages_, CsrGraph rules_,
+                       std::optional<BitGrid> rule_matrix_,
+                       const bool rules_consistent_,
+                       std::optional<std::vector<std::size_t>> page_ranks_,
+                       std::vector<std::vector<std::size_t>> manuals_)
+    : pages(std::move(pages_)), rules(std::move(rules_)),
+      rule_matrix(std::move(rule_matrix_)),
+      rules_consistent(rules_consistent_), page_ranks(std::move(page_ranks_)),
+      manuals(std::move(manuals_)) {}
+PrintQueue::PrintQueue(const PrintQueue &other) = default;
+PrintQueue::PrintQueue(PrintQueue &&other) noexcept = default;
+auto PrintQueue::operator=(const PrintQueue &other) -> PrintQueue & = default;
+auto PrintQueue::operator=(PrintQueue &&other) noexcept
+    -> PrintQueue & = default;
+PrintQueue::~PrintQueue() = default;
+
+struct RuleSet {
+    // the rules section of the input this was parsed from, and the bound on
+    // the rule matrix it was parsed with
+    std::string text;
+    std::size_t max_dense_pages;
+    Interner<int> pages;
+    std::vector<CsrGraph::Edge> edges;
+    CsrGraph rules;
+    std::optional<BitGrid> rule_matrix;
+    bool rules_consistent;
+};
+
+/**
+ * The rules as a num_nodes x num_nodes bit matrix, or nothing if that
+ * would be larger than max_dense_pages^2 bits.
+ */
+auto build_rule_matrix(const CsrGraph &rules,
+                       const std::size_t max_dense_pages)
+    -> std::optional<BitGrid> {
+    if(rules.num_nodes() > max_dense_pages) {
+        return std::nullopt;
+    }
+
+    BitGrid rule_matrix(rules.num_nodes(), rules.num_nodes());
+    for(std::size_t before = 0; before < rules.num_nodes(); ++before) {
+        for(const std::size_t after : rules.neighbors(before)) {
+            rule_matrix.set(before, after);
+        }
+    }
+    return rule_matrix;
+}
+
+/**
+ * The rules section of the input; rule sets over at most max_dense_pages
+ * pages also get a rule matrix.
+ */
+auto parse_rules(const std::string &rules_text,
+                 const std::size_t max_dense_pages) -> RuleSet {
+    std::istringstream rules_stream(rules_text);
+    Interner<int> pages;
+    std::vector<CsrGraph::Edge> edges;
+
+    std::string line;
+    while(std::getline(rules_stream, line)) {
+        const std::vector<std::string> line_parts = split(line, '|');
+
+        const int num1 = std::stoi(line_parts[0]);
+        const int num2 = std::stoi(line_parts[line_parts.size() - 1]);
+        edges.emplace_back(pages.intern(num1), pages.intern(num2));
+    }
+    // a repeated rule line would count twice as a successor, which can make
+    // rules_totally_order accept a manual with an unordered pair
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+    CsrGraph rules(pages.size(), edges);
+    std::optional<BitGrid> rule_matrix =
+        build_rule_matrix(rules, max_dense_pages);
+    const bool rules_consistent = std::none_of(
+        edges.begin(), edges.end(), [&rules](const CsrGraph::Edge &edge) {
+            return rules.has_edge(edge.second, edge.first);
+        });
+    return RuleSet{rules_text, max_dense_pages, pages,
+                   edges,      rules,           rule_matrix,
+                   rules_consistent};
+}
+
+/**
+ * The rules parsed from the most recent input, kept across solves: both
+ * parts, and every re-solve in watch mode, usually see the same rules
+ * section, so only the manuals need parsing again.
+ */
+auto cached_rules(const std::string &rules_text,
+                  const std::size_t max_dense_pages) -> const RuleSet & {
+    static std::optional<RuleSet> cache;
+    if(!cache.has_value() || cache->text != rules_text ||
+       cache->max_dense_pages != max_dense_pages) {
+        cache.emplace(parse_rules(rules_text, max_dense_pages));
+    }
+    return *cache;
+}
+
+/**
+ * Ranks for the pages in use such that every rule goes from a lower rank to
+ * a higher one, if the rules among those pages order each pair of them
+ * directly and without cycles; nothing otherwise. A manual is then valid
+ * exactly when it is sorted by rank, and its fixed order is the sort by rank.
+ *
+ * Kahn's algorithm finds a topological order or a cycle. Without cycles,
+ * k(k - 1) / 2 rules among k pages means one rule per pair, and the
+ * topological order is the only one. parse_rules lists each rule once, so
+ * the rules can be counted as they are.
+ */
+auto compute_page_ranks(const CsrGraph &rules,
+                        const std::vector<bool> &in_use)
+    -> std::optional<std::vector<std::size_t>> {
+    const std::size_t num_pages = rules.num_nodes();
+    std::size_t num_in_use = 0;
+    std::size_t num_rules = 0;
+    std::vector<std::size_t> num_predecessors(num_pages, 0);
+    for(std::size_t page = 0; page < num_pages; ++page) {
+        if(!in_use[page]) {
+            continue;
+        }
+        ++num_in_use;
+        for(const std::size_t next : rules.neighbors(page)) {
+            if(in_use[next]) {
+                ++num_predecessors[next];
+                ++num_rules;
+            }
+        }
+    }
+    if(num_in_use > 0 && num_rules != num_in_use * (num_in_use - 1) / 2) {
+        return std::nullopt;
+    }
+
+    std::vector<std::size_t> order;
+    order.reserve(num_in_use);
+    for(std::size_t page = 0; page < num_pages; ++page) {
+        if(in_use[page] && num_predecessors[page] == 0) {
+            order.push_back(page);
+        }
+    }
+    for(std::size_t i = 0; i < order.size(); ++i) {
+        for(const std::size_t next : rules.neighbors(order[i])) {
+            if(in_use[next] && --num_predecessors[next] == 0) {
+                order.push_back(next);
+            }
+        }
+    }
+    if(order.size() != num_in_use) {
+        return std::nullopt;
+    }
 
-    std::map<int, std::unordered_set<int>> edges;
-    std::vector<std::vector<int>> manual_pages;
+    std::vector<std::size_t> ranks(num_pages, num_pages);
+    for(std::size_t rank = 0; rank < order.size(); ++rank) {
+        ranks[order[rank]] = rank;
+    }
+    return ranks;
+}
+
+/**
+ * compute_page_ranks for the most recent rules and pages in use, kept across
+ * solves like cached_rules: a rule set serving many inputs over the same
+ * pages is ranked once.
+ */
+auto cached_page_ranks(const std::string &rules_text, const CsrGraph &rules,
+                       const std::vector<bool> &in_use)
+    -> const std::optional<std::vector<std::size_t>> & {
+    struct RankCache {
+        std::string rules_text;
+        std::vector<bool> in_use;
+        std::optional<std::vector<std::size_t>> ranks;
+    };
+    static std::optional<RankCache> cache;
+    if(!cache.has_value() || cache->rules_text != rules_text ||
+       cache->in_use != in_use) {
+        cache.emplace(
+            RankCache{rules_text, in_use, compute_page_ranks(rules, in_use)});
+    }
+    return cache->ranks;
+}
 
+static auto parse_input() -> PrintQueue {
+    const std::string input_file_name{"data/day05.txt"};
+    std::istringstream input_file = open_input(input_file_name);
+
+    std::string rules_text;
     std::string line;
-    bool first_part = true;
+    while(std::getline(input_file, line) && !line.empty()) {
+        rules_text += line;
+        rules_text += '\n';
+    }
+    const RuleSet &rule_set = cached_rules(rules_text, max_dense_rule_pages);
+
+    Interner<int> pages = rule_set.pages;
+    std::vector<std::vector<std::size_t>> manuals;
     while(std::getline(input_file, line)) {
         if(line.empty()) {
-            first_part = false;
             continue;
         }
+        const std::vector<std::string> line_parts = split(line, ',');
+        std::vector<std::size_t> manual(line_parts.size());
+        std::transform(line_parts.cbegin(), line_parts.cend(), manual.begin(),
+                       [&pages](const std::string &s) -> std::size_t {
+                           return pages.intern(std::stoi(s));
+                       });
+        manuals.push_back(manual);
+    }
 
-        if(first_part) {
-            const std::vector<std::string> line_parts = split(line, '|');
+    // pages that no rule mentions get fresh ids past the end of the graph;
+    // they have no row in the rule matrix, which is fine, as no rule
+    // constrains them
+    const CsrGraph rules = (pages.size() == rule_set.pages.size())
+                               ? rule_set.rules
+                               : CsrGraph(pages.size(), rule_set.edges);
 
-            const int num1 = std::stoi(line_parts[0]);
-            const int num2 = std::stoi(line_parts[line_parts.size() - 1]);
-            edges[num1].insert(num2);
-        } else {
-            const std::vector<std::string> line_parts = split(line, ',');
-            std::vector<int> pages(line_parts.size());
-            std::transform(
-                line_parts.cbegin(), line_parts.cend(), pages.begin(),
-                [](const std::string &s) -> int { return std::stoi(s); });
-            manual_pages.push_back(pages);
+    std::vector<bool> in_use(pages.size(), false);
+    for(const std::vector<std::size_t> &manual : manuals) {
+        for(const std::size_t page : manual) {
+            in_use[page] = true;
+        }
+    }
+    const std::optional<std::vector<std::size_t>> &page_ranks =
+        cached_page_ranks(rules_text, rules, in_use);
+
+    return PrintQueue{std::move(pages), rules, rule_set.rule_matrix,
+                      rule_set.rules_consistent, page_ranks,
+                      std::move(manuals)};
+}
+
+/**
+ * A manual breaks a rule if some page must come after a page printed
+ * earlier, i.e. the page's row of the rule matrix meets the set of pages
+ * seen so far: one AND per word of the row.
+ *
+ * seen is scratch space shared between manuals, one bit per rule page. It
+ * must be all zero on entry and is left that way: only the bits this manual
+ * set are cleared again, not the whole vector.
+ */
+auto is_valid_manual_dense(const BitGrid &rule_matrix,
+                           const std::vector<std::size_t> &manual,
+                           std::vector<uint64_t> &seen) -> bool {
+    constexpr const std::size_t WORD_BITS = 64;
+
+    bool valid = true;
+    std::size_t num_seen = 0;
+    for(; num_seen < manual.size(); ++num_seen) {
+        const std::size_t page = manual[num_seen];
+        if(page >= rule_matrix.num_rows()) {
+            continue;
+        }
+        const uint64_t *must_follow = rule_matrix.row_data(page);
+        for(std::size_t word = 0; valid && word < seen.size(); ++word) {
+            valid = ((must_follow[word] & seen[word]) == 0);
         }
+        if(!valid) {
+            break;
+        }
+        seen[page / WORD_BITS] |= uint64_t{1} << (page % WORD_BITS);
     }
 
-    return std::pair(edges, manual_pages);
+    for(std::size_t i = 0; i < num_seen; ++i) {
+        if(manual[i] < rule_matrix.num_rows()) {
+            seen[manual[i] / WORD_BITS] = 0;
+        }
+    }
+    return valid;
+}
+
+/**
+ * Cleared scratch space for validating input's manuals against its rule
+ * matrix, if it has one.
+ */
+auto new_seen_pages(const PrintQueue &input) -> std::vector<uint64_t> {
+    return std::vector<uint64_t>(
+        input.rule_matrix.has_value() ? input.rule_matrix->words_per_row() : 0,
+        0);
 }
 
-auto is_valid_manual(const std::map<int, std::unordered_set<int>> &edges,
-                     const std::vector<int> &pages) -> bool {
-    for(std::size_t j = 0; j < pages.size(); ++j) {
+[[gnu::pure]] auto is_valid_manual_sparse(
+    const CsrGraph &rules, const std::vector<std::size_t> &manual) -> bool {
+    for(std::size_t j = 0; j < manual.size(); ++j) {
         for(std::size_t i = 0; i < j; ++i) {
-            const int prev_page = pages[i];
-            const int curr_page = pages[j];
             // search if this violates a rule
-            if(edges.find(curr_page) != edges.end() &&
-               edges.at(curr_page).find(prev_page) !=
-                   edges.at(curr_page).end()) {
+            if(rules.has_edge(manual[j], manual[i])) {
                 return false;
             }
         }
@@ -63,33 +342,52 @@ auto is_valid_manual(const std::map<int, std::unordered_set<int>> &edges,
     return true;
 }
 
-auto topological_sort(const std::map<int, std::unordered_set<int>> &edges,
-                      const std::vector<int> &arr) -> std::vector<int> {
-    const std::unordered_set<int> arr_set(arr.begin(), arr.end());
+/**
+ * seen_pages is scratch space for is_valid_manual_dense, from
+ * new_seen_pages().
+ */
+auto is_valid_manual(const PrintQueue &input,
+                     const std::vector<std::size_t> &manual,
+                     std::vector<uint64_t> &seen_pages) -> bool {
+    if(input.page_ranks.has_value()) {
+        const std::vector<std::size_t> &ranks = *input.page_ranks;
+        const auto by_rank = [&ranks](const std::size_t a,
+                                      const std::size_t b) {
+            return ranks[a] < ranks[b];
+        };
+        return std::is_sorted(manual.begin(), manual.end(), by_rank);
+    }
+    if(input.rule_matrix.has_value()) {
+        return is_valid_manual_dense(*input.rule_matrix, manual, seen_pages);
+    }
+    return is_valid_manual_sparse(input.rules, manual);
+}
+
+template <typename Graph>
+auto topological_sort(const Graph &rules, const std::vector<std::size_t> &arr)
+    -> std::vector<std::size_t> {
+    std::vector<bool> in_arr(rules.num_nodes(), false);
+    for(const std::size_t page : arr) {
+        in_arr[page] = true;
+    }
 
-    std::vector<int> stack(arr.begin(), arr.end());
-    std::vector<int> processed;
-    std::unordered_set<int> have_added_children;
-    std::unordered_set<int> have_added_to_processed;
+    std::vector<std::size_t> stack(arr.begin(), arr.end());
+    std::vector<std::size_t> processed;
+    std::vector<bool> have_added_children(rules.num_nodes(), false);
+    std::vector<bool> have_added_to_processed(rules.num_nodes(), false);
     while(!stack.empty()) {
-        const int last = stack.back();
+        const std::size_t last = stack.back();
 
-        if(have_added_to_processed.find(last) !=
-           have_added_to_processed.end()) {
+        if(have_added_to_processed[last]) {
             stack.pop_back();
             continue;
         }
 
-        if(have_added_children.find(last) == have_added_children.end()) {
+        if(!have_added_children[last]) {
             // first time seeing this element, so expand
-            have_added_children.insert(last);
-            if(edges.find(last) == edges.end()) {
-                continue;
-            }
-            for(const int child : edges.at(last)) {
-                if(arr_set.find(child) != arr_set.end() &&
-                   have_added_children.find(child) ==
-                       have_added_children.end()) {
+            have_added_children[last] = true;
+            for(const std::size_t child : rules.neighbors(last)) {
+                if(in_arr[child] && !have_added_children[child]) {
                     stack.push_back(child);
                 }
             }
@@ -97,7 +395,7 @@ auto topological_sort(const std::map<int, std::unordered_set<int>> &edges,
         } else {
             // second time seeing this element
             processed.push_back(last);
-            have_added_to_processed.insert(last);
+            have_added_to_processed[last] = true;
             stack.pop_back();
         }
     }
@@ -106,18 +404,130 @@ auto topological_sort(const std::map<int, std::unordered_set<int>> &edges,
     return processed;
 }
 
-auto solve_day05a() -> int64_t {
-    std::pair<std::map<int, std::unordered_set<int>>,
-              std::vector<std::vector<int>>>
-        input = parse_input();
+/**
+ * Whether a rule says page a must be printed before page b.
+ */
+[[gnu::pure]] auto precedes(const PrintQueue &input, const std::size_t a,
+                            const std::size_t b) -> bool {
+    if(input.rule_matrix.has_value()) {
+        const std::size_t num_rule_pages = input.rule_matrix->num_rows();
+        return a < num_rule_pages && b < num_rule_pages &&
+               input.rule_matrix->test(a, b);
+    }
+    return input.rules.has_edge(a, b);
+}
+
+/**
+ * Number of pages of the manual that a rule puts after page, given the
+ * manual's pages as a set.
+ */
+[[gnu::pure]] auto
+count_successors_in(const PrintQueue &input, const std::size_t page,
+                    const std::vector<uint64_t> &manual_mask,
+                    const std::vector<bool> &in_manual) -> std::size_t {
+    if(!input.rule_matrix.has_value()) {
+        const std::span<const std::size_t> after = input.rules.neighbors(page);
+        return static_cast<std::size_t>(
+            std::count_if(after.begin(), after.end(),
+                          [&in_manual](const std::size_t other) {
+                              return in_manual[other];
+                          }));
+    }
+    if(page >= input.rule_matrix->num_rows()) {
+        return 0;
+    }
+    const uint64_t *after = input.rule_matrix->row_data(page);
+    std::size_t count = 0;
+    for(std::size_t word = 0; word < manual_mask.size(); ++word) {
+        count += static_cast<std::size_t>(
+            std::popcount(after[word] & manual_mask[word]));
+    }
+    return count;
+}
 
-    const std::map<int, std::unordered_set<int>> edges = input.first;
-    const std::vector<std::vector<int>> manual_pages = input.second;
+/**
+ * Whether the rules order every pair of pages in the manual, so that
+ * precedes() is a strict total order on it and can drive std::nth_element.
+ * With consistent rules that holds exactly when the pages' numbers of
+ * successors within the manual are 0, 1, ..., n - 1: there are then
+ * n(n - 1) / 2 rules among n pages, one per pair, and a tournament with
+ * those scores is transitive.
+ */
+auto rules_totally_order(const PrintQueue &input,
+                         const std::vector<std::size_t> &manual) -> bool {
+    constexpr const std::size_t WORD_BITS = 64;
+
+    if(!input.rules_consistent) {
+        return false;
+    }
+    // the manual's pages as a set, in whichever form the rules are in
+    const bool dense = input.rule_matrix.has_value();
+    std::vector<uint64_t> manual_mask(
+        dense ? input.rule_matrix->words_per_row() : 0, 0);
+    std::vector<bool> in_manual(dense ? 0 : input.rules.num_nodes(), false);
+    for(const std::size_t page : manual) {
+        if(!dense) {
+            in_manual[page] = true;
+        } else if(page < input.rule_matrix->num_rows()) {
+            manual_mask[page / WORD_BITS] |= uint64_t{1} << (page % WORD_BITS);
+        }
+    }
+
+    std::vector<bool> score_seen(manual.size(), false);
+    for(const std::size_t page : manual) {
+        const std::size_t successors =
+            count_successors_in(input, page, manual_mask, in_manual);
+        if(successors >= manual.size() || score_seen[successors]) {
+            return false;
+        }
+        score_seen[successors] = true;
+    }
+
+    return true;
+}
+
+/**
+ * The middle page of manual once put in rule order. When the rules totally
+ * order the manual, only the middle position is settled, with
+ * std::nth_element (comparing global ranks if there are any); otherwise the
+ * whole manual is sorted topologically.
+ */
+auto middle_page_in_rule_order(const PrintQueue &input,
+                               const std::vector<std::size_t> &manual)
+    -> std::size_t {
+    std::vector<std::size_t> pages(manual);
+    const auto middle =
+        pages.begin() + static_cast<std::ptrdiff_t>(pages.size() / 2);
+    if(input.page_ranks.has_value()) {
+        const std::vector<std::size_t> &ranks = *input.page_ranks;
+        std::nth_element(pages.begin(), middle, pages.end(),
+                         [&ranks](const std::size_t a, const std::size_t b) {
+                             return ranks[a] < ranks[b];
+                         });
+        return *middle;
+    }
+
+    if(!rules_totally_order(input, manual)) {
+        const std::vector<std::size_t> fixed_manual =
+            topological_sort(input.rules, manual);
+        return fixed_manual[fixed_manual.size() / 2];
+    }
+
+    std::nth_element(pages.begin(), middle, pages.end(),
+                     [&input](const std::size_t a, const std::size_t b) {
+                         return precedes(input, a, b);
+                     });
+    return *middle;
+}
+
+auto solve_day05a() -> int64_t {
+    const PrintQueue input = parse_input();
+    std::vector<uint64_t> seen_pages = new_seen_pages(input);
 
     int64_t sum_middle = 0;
-    for(const std::vector<int> &pages : manual_pages) {
-        if(is_valid_manual(edges, pages)) {
-            sum_middle += pages[pages.size() / 2];
+    for(const std::vector<std::size_t> &manual : input.manuals) {
+        if(is_valid_manual(input, manual, seen_pages)) {
+            sum_middle += input.pages.name(manual[manual.size() / 2]);
         }
     }
 
@@ -125,20 +535,289 @@ auto solve_day05a() -> int64_t {
 }
 
 auto solve_day05b() -> int64_t {
-    std::pair<std::map<int, std::unordered_set<int>>,
-              std::vector<std::vector<int>>>
-        input = parse_input();
-
-    const std::map<int, std::unordered_set<int>> edges = input.first;
-    const std::vector<std::vector<int>> manual_pages = input.second;
+    const PrintQueue input = parse_input();
+    std::vector<uint64_t> seen_pages = new_seen_pages(input);
 
     int64_t sum_middle = 0;
-    for(const std::vector<int> &pages : manual_pages) {
-        if(!is_valid_manual(edges, pages)) {
-            const std::vector<int> fixed_pages = topological_sort(edges, pages);
-            sum_middle += fixed_pages[fixed_pages.size() / 2];
+    for(const std::vector<std::size_t> &manual : input.manuals) {
+        if(!is_valid_manual(input, manual, seen_pages)) {
+            sum_middle +=
+                input.pages.name(middle_page_in_rule_order(input, manual));
         }
     }
 
     return sum_middle;
 }
+
+/**
+ * Rules that can change: for every page, the pages that must come after it,
+ * sorted and each listed once, as parse_rules leaves them. Offers the part
+ * of CsrGraph's interface that topological_sort uses.
+ */
+class RuleLists {
+  public:
+    explicit RuleLists(const CsrGraph &rules)
+        : successors(rules.num_nodes()) {
+        for(std::size_t before = 0; before < rules.num_nodes(); ++before) {
+            const std::span<const std::size_t> after =
+                rules.neighbors(before);
+            successors[before].assign(after.begin(), after.end());
+        }
+    }
+
+    [[nodiscard]] auto num_nodes() const -> std::size_t {
+        return successors.size();
+    }
+    [[nodiscard]] auto neighbors(const std::size_t node) const
+        -> std::span<const std::size_t> {
+        return successors[node];
+    }
+
+    auto add_node() -> void { successors.emplace_back(); }
+
+    /**
+     * Add the rule before|after; false if it was already there.
+     */
+    auto add(const std::size_t before, const std::size_t after) -> bool {
+        std::vector<std::size_t> &after_list = successors[before];
+        const auto it =
+            std::lower_bound(after_list.begin(), after_list.end(), after);
+        if(it != after_list.end() && *it == after) {
+            return false;
+        }
+        after_list.insert(it, after);
+        return true;
+    }
+
+    /**
+     * Remove the rule before|after; false if it was not there.
+     */
+    auto remove(const std::size_t before, const std::size_t after) -> bool {
+        std::vector<std::size_t> &after_list = successors[before];
+        const auto it =
+            std::lower_bound(after_list.begin(), after_list.end(), after);
+        if(it == after_list.end() || *it != after) {
+            return false;
+        }
+        after_list.erase(it);
+        return true;
+    }
+
+  private:
+    std::vector<std::vector<std::size_t>> successors;
+};
+
+/**
+ * Parts A and B kept up to date while rules are added and removed, for a
+ * fixed set of manuals.
+ *
+ * Every manual counts the rules it breaks: pairs of its pages printed in the
+ * opposite order to a rule. It is valid while the count is zero. Every page
+ * lists where it occurs, as (manual, position) in manual order, so the
+ * manuals holding both pages of a rule come from merging two lists. Adding
+ * or removing a rule only visits those manuals: their count changes if the
+ * rule's second page is printed first, and the invalid ones get their
+ * corrected middle page recomputed. The sums of both parts are adjusted by
+ * the difference.
+ */
+class IncrementalPrintQueue {
+  public:
+    explicit IncrementalPrintQueue(const PrintQueue &input)
+        : pages(input.pages), rules(input.rules), manuals(input.manuals),
+          occurrences(input.pages.size()),
+          num_broken_rules(input.manuals.size(), 0),
+          counted_middles(input.manuals.size(), 0),
+          counted_as_valid(input.manuals.size(), false) {
+        // times each page has been printed so far in the current manual
+        std::vector<int64_t> num_printed(pages.size(), 0);
+        for(std::size_t manual = 0; manual < manuals.size(); ++manual) {
+            const std::vector<std::size_t> &pages_of_manual = manuals[manual];
+            for(std::size_t position = 0; position < pages_of_manual.size();
+                ++position) {
+                const std::size_t page = pages_of_manual[position];
+                occurrences[page].push_back(Occurrence{manual, position});
+                for(const std::size_t after : rules.neighbors(page)) {
+                    num_broken_rules[manual] += num_printed[after];
+                }
+                ++num_printed[page];
+            }
+            for(const std::size_t page : pages_of_manual) {
+                num_printed[page] = 0;
+            }
+            count_manual(manual);
+        }
+    }
+
+    IncrementalPrintQueue(const IncrementalPrintQueue &other);
+    IncrementalPrintQueue(IncrementalPrintQueue &&other) noexcept;
+    auto operator=(const IncrementalPrintQueue &other)
+        -> IncrementalPrintQueue &;
+    auto operator=(IncrementalPrintQueue &&other) noexcept
+        -> IncrementalPrintQueue &;
+    ~IncrementalPrintQueue();
+
+    auto add_rule(const int before, const int after) -> void {
+        update_rule(before, after, true);
+    }
+    auto remove_rule(const int before, const int after) -> void {
+        update_rule(before, after, false);
+    }
+
+    /**
+     * Sum of middle pages of the valid manuals, and of the invalid manuals
+     * once corrected.
+     */
+    [[nodiscard]] auto sums() const -> std::pair<int64_t, int64_t> {
+        return {sum_valid_middles, sum_corrected_middles};
+    }
+
+  private:
+    struct Occurrence {
+        std::size_t manual;
+        std::size_t position;
+    };
+
+    auto page_id(const int page) -> std::size_t {
+        const std::size_t id = pages.intern(page);
+        if(id == occurrences.size()) {
+            // a page no manual holds: no rule about it affects any manual
+            occurrences.emplace_back();
+            rules.add_node();
+        }
+        return id;
+    }
+
+    /**
+     * visit(manual, position of before, position of after) for every manual
+     * holding both pages, once per pair of occurrences.
+     */
+    template <typename Visit>
+    auto for_each_common_manual(const std::size_t before,
+                                const std::size_t after, Visit &&visit) const
+        -> void {
+        const std::vector<Occurrence> &before_list = occurrences[before];
+        const std::vector<Occurrence> &after_list = occurrences[after];
+        const auto run_end = [](const std::vector<Occurrence> &list,
+                                std::size_t index) {
+            const std::size_t manual = list[index].manual;
+            while(index < list.size() && list[index].manual == manual) {
+                ++index;
+            }
+            return index;
+        };
+
+        std::size_t i = 0;
+        std::size_t j = 0;
+        while(i < before_list.size() && j < after_list.size()) {
+            if(before_list[i].manual < after_list[j].manual) {
+                ++i;
+            } else if(after_list[j].manual < before_list[i].manual) {
+                ++j;
+            } else {
+                const std::size_t before_end = run_end(before_list, i);
+                const std::size_t after_end = run_end(after_list, j);
+                for(std::size_t b = i; b < before_end; ++b) {
+                    for(std::size_t a = j; a < after_end; ++a) {
+                        visit(before_list[b].manual, before_list[b].position,
+                              after_list[a].position);
+                    }
+                }
+                i = before_end;
+                j = after_end;
+            }
+        }
+    }
+
+    auto update_rule(const int before_page, const int after_page,
+                     const bool add) -> void {
+        const std::size_t before = page_id(before_page);
+        const std::size_t after = page_id(after_page);
+        if(add ? !rules.add(before, after) : !rules.remove(before, after)) {
+            return;
+        }
+
+        affected.clear();
+        for_each_common_manual(before, after,
+                               [this, add](const std::size_t manual,
+                                           const std::size_t before_position,
+                                           const std::size_t after_position) {
+                                   if(after_position < before_position) {
+                                       num_broken_rules[manual] += add ? 1 : -1;
+                                   }
+                                   if(affected.empty() ||
+                                      affected.back() != manual) {
+                                       affected.push_back(manual);
+                                   }
+                               });
+        for(const std::size_t manual : affected) {
+            uncount_manual(manual);
+            count_manual(manual);
+        }
+    }
+
+    auto count_manual(const std::size_t manual) -> void {
+        const std::vector<std::size_t> &pages_of_manual = manuals[manual];
+        const std::size_t middle = pages_of_manual.size() / 2;
+        counted_as_valid[manual] = (num_broken_rules[manual] == 0);
+        if(counted_as_valid[manual]) {
+            counted_middles[manual] = pages.name(pages_of_manual[middle]);
+            sum_valid_middles += counted_middles[manual];
+        } else {
+            counted_middles[manual] =
+                pages.name(topological_sort(rules, pages_of_manual)[middle]);
+            sum_corrected_middles += counted_middles[manual];
+        }
+    }
+
+    auto uncount_manual(const std::size_t manual) -> void {
+        (counted_as_valid[manual] ? sum_valid_middles
+                                  : sum_corrected_middles) -=
+            counted_middles[manual];
+    }
+
+    Interner<int> pages;
+    RuleLists rules;
+    std::vector<std::vector<std::size_t>> manuals;
+    std::vector<std::vector<Occurrence>> occurrences;
+    std::vector<int64_t> num_broken_rules;
+    // what each manual currently adds to one of the sums
+    std::vector<int64_t> counted_middles;
+    std::vector<bool> counted_as_valid;
+    int64_t sum_valid_middles = 0;
+    int64_t sum_corrected_middles = 0;
+    // manuals touched by the current update, reused between updates
+    std::vector<std::size_t> affected{};
+};
+
+IncrementalPrintQueue::IncrementalPrintQueue(
+    const IncrementalPrintQueue &other) = default;
+IncrementalPrintQueue::IncrementalPrintQueue(
+    IncrementalPrintQueue &&other) noexcept = default;
+auto IncrementalPrintQueue::operator=(const IncrementalPrintQueue &other)
+    -> IncrementalPrintQueue & = default;
+auto IncrementalPrintQueue::operator=(IncrementalPrintQueue &&other) noexcept
+    -> IncrementalPrintQueue & = default;
+IncrementalPrintQueue::~IncrementalPrintQueue() = default;
+
+auto replay_day05_rule_updates(
+    const std::vector<Day05RuleUpdate> &updates,
+    const std::function<void(std::size_t, int64_t, int64_t)> &report)
+    -> std::pair<int64_t, int64_t> {
+    IncrementalPrintQueue queue(parse_input());
+    const auto report_sums = [&queue, &report](const std::size_t num_applied) {
+        const auto [valid_sum, corrected_sum] = queue.sums();
+        report(num_applied, valid_sum, corrected_sum);
+    };
+
+    report_sums(0);
+    for(std::size_t i = 0; i < updates.size(); ++i) {
+        if(updates[i].add) {
+            queue.add_rule(updates[i].before, updates[i].after);
+        } else {
+            queue.remove_rule(updates[i].before, updates[i].after);
+        }
+        report_sums(i + 1);
+    }
+
+    return queue.sums();
+}
@@ -1,18 +1,23 @@
 #include <algorithm>
+#include <bit> // std::popcount
 #include <cstddef>
-#include <fstream>
+#include <cstdint>
 #include <functional>
 #include <set>
+#include <sstream>
 #include <string>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "bit_grid.hpp"
 #include "day.hpp"
+#include "utils.hpp"
 
 constexpr const char FREE = '.';
 constexpr const char OBSTACLE = '#';
 constexpr const char START = '^';
+constexpr const std::size_t NUM_DIRECTIONS = 4;
 
 enum class StopReason {
     None,
@@ -23,16 +28,12 @@ enum class StopReason {
 
 struct WalkResult {
     unsigned int num_steps;
-    std::set<std::pair<std::size_t, std::size_t>> visited_positions;
-    std::set<
-        std::pair<std::pair<std::size_t, std::size_t>, std::pair<int, int>>>
-        visited_position_with_direction;
     bool in_loop;
 };
 
 static auto parse_input() -> std::vector<std::string> {
     const std::string input_file_name{"data/day06.txt"};
-    std::ifstream input_file{input_file_name};
+    std::istringstream input_file = open_input(input_file_name);
 
     std::vector<std::string> grid;
     std::string line;
@@ -79,6 +80,24 @@ auto turn_right(const std::pair<int, int> current_direction)
                                -current_direction.first);
 }
 
+/**
+ * 0 for up, then clockwise, so that turning right adds one modulo
+ * NUM_DIRECTIONS.
+ */
+[[gnu::const]] auto direction_index(const std::pair<int, int> direction)
+    -> std::size_t {
+    if(direction.first == -1) {
+        return 0;
+    }
+    if(direction.second == 1) {
+        return 1;
+    }
+    if(direction.first == 1) {
+        return 2;
+    }
+    return 3;
+}
+
 auto find_start_position(const std::vector<std::string> &grid)
     -> std::pair<std::size_t, std::size_t> {
     for(std::size_t i = 0; i < grid.size(); ++i) {
@@ -93,25 +112,38 @@ auto find_start_position(const std::vector<std::string> &grid)
 }
 
 /**
- * Walk in direction from starting_position in grid, until an obstacle is hit,
- * or hit edge.
+ * Walk in direction from starting_position in grid, turning right at
+ * obstacles, until the walk leaves the grid or repeats a state. Every
+ * (position, direction) state reached is set in visited_states, which has
+ * NUM_DIRECTIONS columns per grid column: state (row, col, direction) is bit
+ * (row, col * NUM_DIRECTIONS + direction index). visited_states belongs to
+ * the caller and is cleared here, so the walk itself allocates nothing.
  */
 auto walk(const std::vector<std::string> &grid,
           const std::pair<std::size_t, std::size_t> starting_position,
-          const std::pair<int, int> starting_direction) -> WalkResult {
+          const std::pair<int, int> starting_direction,
+          BitGrid &visited_states) -> WalkResult {
+    visited_states.clear();
+    // false if the state had been visited before
+    const auto visit = [&visited_states](const std::size_t row,
+                                         const std::size_t col,
+                                         const std::size_t direction) {
+        const std::size_t state_col = col * NUM_DIRECTIONS + direction;
+        if(visited_states.test(row, state_col)) {
+            return false;
+        }
+        visited_states.set(row, state_col);
+        return true;
+    };
 
     unsigned int num_steps = 0;
-    std::set<std::pair<std::size_t, std::size_t>> visited_positions{
-        starting_position};
-    std::set<
-        std::pair<std::pair<std::size_t, std::size_t>, std::pair<int, int>>>
-        visited_position_with_direction{
-            std::pair(starting_position, starting_direction)};
     bool in_loop = false;
 
     std::size_t current_row = starting_position.first;
     std::size_t current_col = starting_position.second;
     std::pair<int, int> direction = starting_direction;
+    std::size_t current_direction_index = direction_index(starting_direction);
+    visit(current_row, current_col, current_direction_index);
 
     while(valid_next_position(grid.size(), grid[0].size(), current_row,
                               current_col, direction)) {
@@ -121,58 +153,59 @@ auto walk(const std::vector<std::string> &grid,
             next_position(current_col, direction.second);
         if(grid[next_row][next_col] == OBSTACLE) {
             direction = turn_right(direction);
-
-            const std::pair<std::pair<std::size_t, std::size_t>,
-                            std::pair<int, int>>
-                next_position_with_direction =
-                    std::pair(std::pair(current_row, current_col), direction);
-
-            if(visited_position_with_direction.find(
-                   next_position_with_direction) !=
-               visited_position_with_direction.end()) {
+            current_direction_index =
+                (current_direction_index + 1) % NUM_DIRECTIONS;
+            if(!visit(current_row, current_col, current_direction_index)) {
                 in_loop = true;
                 break;
             }
-            visited_position_with_direction.insert(
-                next_position_with_direction);
             continue;
         }
 
         current_row = next_row;
         current_col = next_col;
         num_steps++;
-        const std::pair<std::size_t, std::size_t> current_position_after_moving(
-            current_row, current_col);
-        visited_positions.insert(current_position_after_moving);
-        const std::pair<std::pair<std::size_t, std::size_t>,
-                        std::pair<int, int>>
-            current_position_with_direction_after_moving =
-                std::pair(current_position_after_moving, direction);
-        if(visited_position_with_direction.find(
-               current_position_with_direction_after_moving) !=
-           visited_position_with_direction.end()) {
+        if(!visit(current_row, current_col, current_direction_index)) {
             in_loop = true;
             break;
         }
-        visited_position_with_direction.insert(
-            current_position_with_direction_after_moving);
     }
 
-    return WalkResult{num_steps, visited_positions,
-                      visited_position_with_direction, in_loop};
+    return WalkResult{num_steps, in_loop};
+}
+
+/**
+ * Grid cells with at least one visited state. A word of visited_states holds
+ * whole cells, NUM_DIRECTIONS bits each, so folding each cell's bits onto its
+ * lowest one leaves one popcount per word.
+ */
+[[gnu::pure]] auto count_visited_cells(const BitGrid &visited_states)
+    -> std::size_t {
+    constexpr const uint64_t LOWEST_BIT_OF_EACH_CELL = 0x1111111111111111ULL;
+
+    std::size_t count = 0;
+    for(std::size_t row = 0; row < visited_states.num_rows(); ++row) {
+        const uint64_t *states = visited_states.row_data(row);
+        for(std::size_t word = 0; word < visited_states.words_per_row();
+            ++word) {
+            const uint64_t any_direction = states[word] | (states[word] >> 1U) |
+                                           (states[word] >> 2U) |
+                                           (states[word] >> 3U);
+            count += static_cast<std::size_t>(
+                std::popcount(any_direction & LOWEST_BIT_OF_EACH_CELL));
+        }
+    }
+    return count;
 }
 
 auto solve_day06a() -> int64_t {
     const std::vector<std::string> grid = parse_input();
     const std::pair<std::size_t, std::size_t> starting_position =
         find_start_position(grid);
-    const WalkResult walk_result =
-        walk(grid, starting_position, std::pair(-1, 0));
-    const std::set<std::pair<std::size_t, std::size_t>> visited_positions =
-        walk_result.visited_positions;
+    BitGrid visited_states(grid.size(), grid[0].size() * NUM_DIRECTIONS);
+    walk(grid, starting_position, std::pair(-1, 0), visited_states);
 
-    const auto result = static_cast<int64_t>(visited_positions.size());
-    return result;
+    return static_cast<int64_t>(count_visited_cells(visited_states));
 }
 
 auto get_obstacle_locations(const std::vector<std::string> &grid)
@@ -1,18 +1,19 @@
 #include <algorithm>
 #include <cstddef>
-#include <fstream>
 #include <functional> // std::function, std::multiplies, std::plus
+#include <sstream>    // std::istringstream
 #include <string>     // std::stoll, std::string, std::to_string
 #include <utility>
 #include <vector>
 
+#include "cancellation.hpp"
 #include "day.hpp"
 #include "utils.hpp"
 
 static auto parse_input()
     -> std::vector<std::pair<int64_t, std::vector<int64_t>>> {
     const std::string input_file_name{"data/day07.txt"};
-    std::ifstream input_file{input_file_name};
+    std::istringstream input_file = open_input(input_file_name);
 
     std::vector<std::pair<int64_t, std::vector<int64_t>>> input;
     std::string line;
@@ -40,6 +41,8 @@ auto match_equation_helper(
     if(1 + current_number_index == numbers.size()) {
         return current_total == desired_total;
     }
+    // leaves outnumber inner calls, so polling here is enough
+    check_cancellation();
 
     for(const std::function<int64_t(int64_t, int64_t)> &binary_operator :
         operators) {
@@ -1,19 +1,20 @@
 #include <cstddef>
-#include <fstream>
 #include <numeric> // std::gcd
 #include <set>
+#include <sstream>
 #include <string>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "day.hpp"
+#include "utils.hpp"
 
 constexpr const char NON_OBSTACLE = '.';
 
 static auto parse_input() -> std::vector<std::string> {
     const std::string input_file_name{"data/day08.txt"};
-    std::ifstream input_file{input_file_name};
+    std::istringstream input_file = open_input(input_file_name);
 
     std::vector<std::string> grid;
     std::string line;
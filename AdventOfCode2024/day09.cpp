@@ -1,15 +1,16 @@
 #include <algorithm>
 #include <cstdint>
-#include <fstream>
 #include <limits>
 #include <map>
 #include <set>
+#include <sstream>
 #include <string>
 #include <tuple>
 #include <utility>
 #include <vector>
 
 #include "day.hpp"
+#include "utils.hpp"
 
 constexpr const int BASE = 10;
 
@@ -55,7 +56,7 @@ class SegmentTree {
 
 static auto parse_input() -> std::string {
     const std::string input_file_name{"data/day09.txt"};
-    std::ifstream input_file{input_file_name};
+    std::istringstream input_file = open_input(input_file_name);
     std::string input;
     std::getline(input_file, input);
     return input;
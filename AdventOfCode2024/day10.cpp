@@ -1,17 +1,19 @@
 #include <cstdint>
-#include <fstream>
 #include <queue>
+#include <sstream>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "bit_grid.hpp"
 #include "day.hpp"
+#include "utils.hpp"
 
 constexpr const int BASE = 10;
 
 static auto parse_input() -> std::vector<std::vector<int>> {
     const std::string input_file_name{"data/day10.txt"};
-    std::ifstream input_file{input_file_name};
+    std::istringstream input_file = open_input(input_file_name);
 
     std::vector<std::vector<int>> input;
     std::string line;
@@ -25,12 +27,15 @@ static auto parse_input() -> std::vector<std::vector<int>> {
     return input;
 }
 
+/**
+ * visited is scratch space shared between trailheads; it is cleared here.
+ */
 auto score_individual_0(const std::vector<std::vector<int>> &grid,
-                        const std::size_t starting_row,
+                        BitGrid &visited, const std::size_t starting_row,
                         const std::size_t starting_col) -> int {
     const std::size_t R = grid.size();
     const std::size_t C = grid[0].size();
-    std::vector<std::vector<bool>> visited(R, std::vector<bool>(C, false));
+    visited.clear();
     int num9 = 0;
 
     std::queue<std::pair<std::size_t, std::size_t>> q;
@@ -42,35 +47,35 @@ auto score_individual_0(const std::vector<std::vector<int>> &grid,
         const std::size_t row = position.first;
         const std::size_t col = position.second;
 
-        if(visited[row][col]) {
+        if(visited.test(row, col)) {
             continue;
         }
-        visited[row][col] = true;
+        visited.set(row, col);
         if(grid[row][col] == BASE - 1) {
             ++num9;
             continue;
         }
 
         if(0 < row && row < R + 1 && col < C) {
-            if(!visited[row - 1][col] &&
+            if(!visited.test(row - 1, col) &&
                grid[row - 1][col] == grid[row][col] + 1) {
                 q.emplace(row - 1, col);
             }
         }
         if(row + 1 < R && col < C) {
-            if(!visited[row + 1][col] &&
+            if(!visited.test(row + 1, col) &&
                grid[row + 1][col] == grid[row][col] + 1) {
                 q.emplace(row + 1, col);
             }
         }
         if(row < R && 0 < col && col < C + 1) {
-            if(!visited[row][col - 1] &&
+            if(!visited.test(row, col - 1) &&
                grid[row][col - 1] == grid[row][col] + 1) {
                 q.emplace(row, col - 1);
             }
         }
         if(row < R && col + 1 < C) {
-            if(!visited[row][col + 1] &&
+            if(!visited.test(row, col + 1) &&
                grid[row][col + 1] == grid[row][col] + 1) {
                 q.emplace(row, col + 1);
             }
@@ -82,12 +87,13 @@ auto score_individual_0(const std::vector<std::vector<int>> &grid,
 
 auto solve_day10a() -> int64_t {
     const std::vector<std::vector<int>> grid = parse_input();
+    BitGrid visited(grid.size(), grid[0].size());
 
     int64_t total_score = 0;
     for(std::size_t i = 0; i < grid.size(); ++i) {
         for(std::size_t j = 0; j < grid[i].size(); ++j) {
             if(grid[i][j] == 0) {
-                total_score += score_individual_0(grid, i, j);
+                total_score += score_individual_0(grid, visited, i, j);
             }
         }
     }
@@ -100,7 +106,7 @@ auto rate_every_cell(const std::vector<std::vector<int>> &grid)
     const std::size_t R = grid.size();
     const std::size_t C = grid[0].size();
     std::vector<std::vector<int>> scores(R, std::vector<int>(C, -1));
-    std::vector<std::vector<bool>> visited(R, std::vector<bool>(C, false));
+    BitGrid visited(R, C);
 
     std::queue<std::pair<std::size_t, std::size_t>> q;
     for(std::size_t i = 0; i < R; ++i) {
@@ -117,10 +123,10 @@ auto rate_every_cell(const std::vector<std::vector<int>> &grid)
         const std::size_t row = position.first;
         const std::size_t col = position.second;
 
-        if(visited[row][col]) {
+        if(visited.test(row, col)) {
             continue;
         }
-        visited[row][col] = true;
+        visited.set(row, col);
 
         int sum = 0;
         if(0 < row && row < R + 1 && col < C) {
@@ -128,7 +134,7 @@ auto rate_every_cell(const std::vector<std::vector<int>> &grid)
                scores[row - 1][col] >= 0) {
                 sum += scores[row - 1][col];
             }
-            if(!visited[row - 1][col] &&
+            if(!visited.test(row - 1, col) &&
                grid[row - 1][col] == grid[row][col] - 1) {
                 q.emplace(row - 1, col);
             }
@@ -138,7 +144,7 @@ auto rate_every_cell(const std::vector<std::vector<int>> &grid)
                scores[row + 1][col] >= 0) {
                 sum += scores[row + 1][col];
             }
-            if(!visited[row + 1][col] &&
+            if(!visited.test(row + 1, col) &&
                grid[row + 1][col] == grid[row][col] - 1) {
                 q.emplace(row + 1, col);
             }
@@ -148,7 +154,7 @@ auto rate_every_cell(const std::vector<std::vector<int>> &grid)
                scores[row][col - 1] >= 0) {
                 sum += scores[row][col - 1];
             }
-            if(!visited[row][col - 1] &&
+            if(!visited.test(row, col - 1) &&
                grid[row][col - 1] == grid[row][col] - 1) {
                 q.emplace(row, col - 1);
             }
@@ -158,7 +164,7 @@ auto rate_every_cell(const std::vector<std::vector<int>> &grid)
                scores[row][col + 1] >= 0) {
                 sum += scores[row][col + 1];
             }
-            if(!visited[row][col + 1] &&
+            if(!visited.test(row, col + 1) &&
                grid[row][col + 1] == grid[row][col] - 1) {
                 q.emplace(row, col + 1);
             }
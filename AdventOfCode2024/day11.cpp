@@ -1,16 +1,16 @@
 #include <algorithm>
 #include <cstdint>
-#include <fstream>
+#include <sstream>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 #include "day.hpp"
+#include "memo_cache.hpp"
 #include "utils.hpp"
 
 static auto parse_input() -> std::vector<int64_t> {
     const std::string input_file_name{"data/day11.txt"};
-    std::ifstream input_file{input_file_name};
+    std::istringstream input_file = open_input(input_file_name);
 
     std::string line;
     std::getline(input_file, line);
@@ -24,49 +24,56 @@ static auto parse_input() -> std::vector<int64_t> {
     return stone_values;
 }
 
-auto blink_at_stones(const std::unordered_map<int64_t, int64_t> &initial_stones)
-    -> std::unordered_map<int64_t, int64_t> {
-    constexpr const int STONE_MULTIPLIER = 2024;
-    std::unordered_map<int64_t, int64_t> next_stones;
+/**
+ * Stones never interact, so the number of stones one stone becomes depends
+ * only on its value and the number of blinks; one memo serves every input.
+ */
+auto stone_count_cache() -> MemoCache<2, int64_t> & {
+    static MemoCache<2, int64_t> stone_counts;
+    return stone_counts;
+}
 
-    for(const auto prior_value_and_count : initial_stones) {
-        const int64_t value = prior_value_and_count.first;
-        const int64_t count = prior_value_and_count.second;
-        if(value == 0) {
-            next_stones[1] += count;
-            continue;
-        }
+auto count_stones(const int64_t value, const int num_blinks) -> int64_t {
+    constexpr const int STONE_MULTIPLIER = 2024;
 
-        const std::string stone_rep = std::to_string(value);
-        if(stone_rep.size() % 2 == 0) {
-            const int64_t left_stone =
-                std::stoll(stone_rep.substr(0, stone_rep.size() / 2));
-            const int64_t right_stone =
-                std::stoll(stone_rep.substr(stone_rep.size() / 2));
-            next_stones[left_stone] += count;
-            next_stones[right_stone] += count;
-        } else {
-            next_stones[value * STONE_MULTIPLIER] += count;
-        }
+    if(num_blinks == 0) {
+        return 1;
     }
+    return stone_count_cache().get_or_compute(
+        {value, num_blinks}, [&]() -> int64_t {
+            if(value == 0) {
+                return count_stones(1, num_blinks - 1);
+            }
 
-    return next_stones;
+            int num_digits = 0;
+            for(int64_t rest = value; rest > 0; rest /= 10) {
+                ++num_digits;
+            }
+            if(num_digits % 2 == 0) {
+                int64_t half_power_of_ten = 1;
+                for(int i = 0; i < num_digits / 2; ++i) {
+                    half_power_of_ten *= 10;
+                }
+                const int64_t left_stone = value / half_power_of_ten;
+                const int64_t right_stone = value % half_power_of_ten;
+                return count_stones(left_stone, num_blinks - 1) +
+                       count_stones(right_stone, num_blinks - 1);
+            }
+            return count_stones(value * STONE_MULTIPLIER, num_blinks - 1);
+        });
 }
 
 auto blink_at_stones_many_times(const std::vector<int64_t> &stones,
                                 const int num_times_to_blink) -> int64_t {
-    std::unordered_map<int64_t, int64_t> stone_value_to_count;
-    for(const int64_t stone : stones) {
-        stone_value_to_count[stone]++;
-    }
-
-    for(int i = 0; i < num_times_to_blink; ++i) {
-        stone_value_to_count = blink_at_stones(stone_value_to_count);
-    }
+    // 75 blinks over a typical input visit about 10^5 (value, blinks) pairs;
+    // sizing the memo up front avoids rehashing it repeatedly while it fills
+    constexpr const std::size_t SUBPROBLEMS_PER_BLINK = 1500;
+    stone_count_cache().reserve(SUBPROBLEMS_PER_BLINK *
+                                static_cast<std::size_t>(num_times_to_blink));
 
     int64_t total_number_of_stones = 0;
-    for(const auto stone_value_and_counts : stone_value_to_count) {
-        total_number_of_stones += stone_value_and_counts.second;
+    for(const int64_t stone : stones) {
+        total_number_of_stones += count_stones(stone, num_times_to_blink);
     }
     return total_number_of_stones;
 }
@@ -81,4 +88,4 @@ auto solve_day11b() -> int64_t {
     constexpr const int NUM_TIMES_TO_BLINK = 75;
     const std::vector<int64_t> stones = parse_input();
     return blink_at_stones_many_times(stones, NUM_TIMES_TO_BLINK);
-}
\ No newline at end of file
+}
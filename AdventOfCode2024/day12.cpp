@@ -1,16 +1,18 @@
 #include <cstdint>
-#include <fstream>
 #include <queue>
+#include <sstream>
 #include <string>
-#include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "bit_grid.hpp"
 #include "day.hpp"
+#include "flat_hash_map.hpp"
+#include "utils.hpp"
 
 static auto parse_input() -> std::vector<std::string> {
     const std::string input_file_name{"data/day12.txt"};
-    std::ifstream input_file{input_file_name};
+    std::istringstream input_file = open_input(input_file_name);
 
     std::vector<std::string> grid;
     std::string line;
@@ -23,8 +25,7 @@ static auto parse_input() -> std::vector<std::string> {
 
 auto fill_in_region_id(const std::vector<std::string> &grid,
                        std::vector<std::vector<int>> &grid_region_ids,
-                       std::vector<std::vector<bool>> &visited,
-                       const std::size_t starting_row,
+                       BitGrid &visited, const std::size_t starting_row,
                        const std::size_t starting_col, const int region_id)
     -> void {
     std::queue<std::pair<std::size_t, std::size_t>> q;
@@ -37,34 +38,34 @@ auto fill_in_region_id(const std::vector<std::string> &grid,
         const std::size_t current_row = current_position.first;
         const std::size_t current_col = current_position.second;
 
-        if(visited[current_row][current_col]) {
+        if(visited.test(current_row, current_col)) {
             continue;
         }
-        visited[current_row][current_col] = true;
+        visited.set(current_row, current_col);
         grid_region_ids[current_row][current_col] = region_id;
 
         if(0 < current_row &&
            grid[current_row - 1][current_col] ==
                grid[current_row][current_col] &&
-           !visited[current_row - 1][current_col]) {
+           !visited.test(current_row - 1, current_col)) {
             q.emplace(current_row - 1, current_col);
         }
         if(current_row + 1 < grid.size() &&
            grid[current_row + 1][current_col] ==
                grid[current_row][current_col] &&
-           !visited[current_row + 1][current_col]) {
+           !visited.test(current_row + 1, current_col)) {
             q.emplace(current_row + 1, current_col);
         }
         if(0 < current_col &&
            grid[current_row][current_col - 1] ==
                grid[current_row][current_col] &&
-           !visited[current_row][current_col - 1]) {
+           !visited.test(current_row, current_col - 1)) {
             q.emplace(current_row, current_col - 1);
         }
         if(current_col + 1 < grid[current_row].size() &&
            grid[current_row][current_col + 1] ==
                grid[current_row][current_col] &&
-           !visited[current_row][current_col + 1]) {
+           !visited.test(current_row, current_col + 1)) {
             q.emplace(current_row, current_col + 1);
         }
     }
@@ -76,12 +77,12 @@ auto partition_grid(const std::vector<std::string> &grid)
     const std::size_t C = grid[0].size();
 
     std::vector<std::vector<int>> grid_region_ids(R, std::vector<int>(C, -1));
-    std::vector<std::vector<bool>> visited(R, std::vector<bool>(C, false));
+    BitGrid visited(R, C);
     int region_id = 0;
 
     for(std::size_t i = 0; i < R; ++i) {
         for(std::size_t j = 0; j < C; ++j) {
-            if(!visited[i][j]) {
+            if(!visited.test(i, j)) {
                 fill_in_region_id(grid, grid_region_ids, visited, i, j,
                                   region_id);
                 ++region_id;
@@ -93,8 +94,8 @@ auto partition_grid(const std::vector<std::string> &grid)
 }
 
 auto find_area(const std::vector<std::vector<int>> &grid_region_ids)
-    -> std::unordered_map<int, int> {
-    std::unordered_map<int, int> region_id_to_area;
+    -> FlatHashMap<int, int> {
+    FlatHashMap<int, int> region_id_to_area;
 
     for(const auto &row : grid_region_ids) {
         for(const auto region_id : row) {
@@ -106,8 +107,8 @@ auto find_area(const std::vector<std::vector<int>> &grid_region_ids)
 }
 
 auto find_perimeter(const std::vector<std::vector<int>> &grid_region_ids)
-    -> std::unordered_map<int, int> {
-    std::unordered_map<int, int> region_id_to_perimeter;
+    -> FlatHashMap<int, int> {
+    FlatHashMap<int, int> region_id_to_perimeter;
 
     for(std::size_t i = 0; i < grid_region_ids.size(); ++i) {
         for(std::size_t j = 0; j < grid_region_ids[i].size(); ++j) {
@@ -128,8 +129,8 @@ auto find_perimeter(const std::vector<std::vector<int>> &grid_region_ids)
 }
 
 auto find_number_of_edges(const std::vector<std::vector<int>> &grid_region_ids)
-    -> std::unordered_map<int, int> {
-    std::unordered_map<int, int> region_id_to_edges;
+    -> FlatHashMap<int, int> {
+    FlatHashMap<int, int> region_id_to_edges;
 
     for(std::size_t i = 0; i < grid_region_ids.size(); ++i) {
         for(std::size_t j = 0; j < grid_region_ids[i].size(); ++j) {
@@ -199,15 +200,18 @@ auto find_number_of_edges(const std::vector<std::vector<int>> &grid_region_ids)
     return region_id_to_edges;
 }
 
-auto find_total_fencing_price(
-    const std::unordered_map<int, int> &region_id_to_area,
-    const std::unordered_map<int, int> &region_id_to_perimeter) -> int64_t {
+[[gnu::pure]] auto find_total_fencing_price(
+    const FlatHashMap<int, int> &region_id_to_area,
+    const FlatHashMap<int, int> &region_id_to_perimeter) -> int64_t {
     int64_t total_price = 0;
-    for(const auto region_id_and_area : region_id_to_area) {
-        const int region_id = region_id_and_area.first;
-        const int area = region_id_and_area.second;
-        const int perimeter = region_id_to_perimeter.at(region_id);
-        total_price += area * perimeter;
+    for(const auto &region_id_and_area : region_id_to_area) {
+        const int region_id = region_id_and_area.key;
+        const int area = region_id_and_area.value;
+        // a region without any fence costs nothing
+        const int *perimeter = region_id_to_perimeter.find(region_id);
+        if(perimeter != nullptr) {
+            total_price += area * *perimeter;
+        }
     }
 
     return total_price;
@@ -216,9 +220,8 @@ auto find_total_fencing_price(
 auto solve_day12a() -> int64_t {
     const std::vector<std::string> grid = parse_input();
     const std::vector<std::vector<int>> grid_region_ids = partition_grid(grid);
-    const std::unordered_map<int, int> region_id_to_area =
-        find_area(grid_region_ids);
-    const std::unordered_map<int, int> region_id_to_perimeter =
+    const FlatHashMap<int, int> region_id_to_area = find_area(grid_region_ids);
+    const FlatHashMap<int, int> region_id_to_perimeter =
         find_perimeter(grid_region_ids);
 
     return find_total_fencing_price(region_id_to_area, region_id_to_perimeter);
@@ -227,9 +230,8 @@ auto solve_day12a() -> int64_t {
 auto solve_day12b() -> int64_t {
     const std::vector<std::string> grid = parse_input();
     const std::vector<std::vector<int>> grid_region_ids = partition_grid(grid);
-    const std::unordered_map<int, int> region_id_to_area =
-        find_area(grid_region_ids);
-    const std::unordered_map<int, int> region_id_to_edges =
+    const FlatHashMap<int, int> region_id_to_area = find_area(grid_region_ids);
+    const FlatHashMap<int, int> region_id_to_edges =
         find_number_of_edges(grid_region_ids);
 
     return find_total_fencing_price(region_id_to_area, region_id_to_edges);
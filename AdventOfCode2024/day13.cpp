@@ -1,13 +1,14 @@
 #include <algorithm>
 #include <cstdint>
-#include <fstream>
 #include <regex>
+#include <sstream>
 #include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "day.hpp"
+#include "utils.hpp"
 
 constexpr const int NUM_TOKENS_TO_PRESS_BUTTON_A = 3;
 constexpr const int NUM_TOKENS_TO_PRESS_BUTTON_B = 1;
@@ -25,7 +26,7 @@ struct ClawMachine {
 static auto parse_input(const bool with_prize_offset)
     -> std::vector<ClawMachine> {
     const std::string input_file_name{"data/day13.txt"};
-    std::ifstream input_file{input_file_name};
+    std::istringstream input_file = open_input(input_file_name);
 
     const std::regex retrieve_button_a_distances(
         R"(Button A: X\+(\d+), Y\+(\d+))");
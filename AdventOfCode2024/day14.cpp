@@ -1,12 +1,15 @@
 #include <cstdint>
-#include <fstream>
 #include <iostream>
 #include <regex>
+#include <sstream>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "bit_grid.hpp"
+#include "cancellation.hpp"
 #include "day.hpp"
+#include "utils.hpp"
 
 constexpr const int BATHROOM_WIDTH = 101;
 constexpr const int BATHROOM_HEIGHT = 103;
@@ -68,7 +71,7 @@ class RestroomRobot {
 
 static auto parse_input() -> std::vector<RestroomRobot> {
     const std::string input_file_name{"data/day14.txt"};
-    std::ifstream input_file{input_file_name};
+    std::istringstream input_file = open_input(input_file_name);
 
     const std::regex retrieve_robot_info(
         R"(p=(-?\d+),(-?\d+) v=(-?\d+),(-?\d+))");
@@ -87,18 +90,23 @@ static auto parse_input() -> std::vector<RestroomRobot> {
     return restroom_robots;
 }
 
-auto print_robot_positions(const std::vector<RestroomRobot> &robots) -> void {
-    std::vector<std::vector<bool>> visited(
-        BATHROOM_HEIGHT, std::vector<bool>(BATHROOM_WIDTH, false));
-    for(const auto robot : robots) {
+auto mark_robot_positions(const std::vector<RestroomRobot> &robots,
+                          BitGrid &occupied) -> void {
+    occupied.clear();
+    for(const auto &robot : robots) {
         const std::pair<int, int> current_position =
             robot.get_current_position();
-        visited[static_cast<std::size_t>(current_position.second)]
-               [static_cast<std::size_t>(current_position.first)] = true;
+        occupied.set(static_cast<std::size_t>(current_position.second),
+                     static_cast<std::size_t>(current_position.first));
     }
-    for(const auto &row : visited) {
-        for(const bool is_visited : row) {
-            if(is_visited) {
+}
+
+auto print_robot_positions(const std::vector<RestroomRobot> &robots) -> void {
+    BitGrid occupied(BATHROOM_HEIGHT, BATHROOM_WIDTH);
+    mark_robot_positions(robots, occupied);
+    for(std::size_t i = 0; i < occupied.num_rows(); ++i) {
+        for(std::size_t j = 0; j < occupied.num_cols(); ++j) {
+            if(occupied.test(i, j)) {
                 std::cout << 'R';
             } else {
                 std::cout << '.';
@@ -108,61 +116,28 @@ auto print_robot_positions(const std::vector<RestroomRobot> &robots) -> void {
     }
 }
 
+/**
+ * occupied and has_neighbor are scratch grids reused from second to second.
+ */
 auto find_percentage_of_robot_positions_have_at_least_one_neighbor(
-    const std::vector<RestroomRobot> &robots) -> double {
-    std::vector<std::vector<bool>> visited(
-        BATHROOM_HEIGHT, std::vector<bool>(BATHROOM_WIDTH, false));
-    for(const auto robot : robots) {
-        const std::pair<int, int> current_position =
-            robot.get_current_position();
-        visited[static_cast<std::size_t>(current_position.second)]
-               [static_cast<std::size_t>(current_position.first)] = true;
-    }
-
-    int number_of_robot_positions = 0;
-    for(const auto &row : visited) {
-        for(const bool is_visited : row) {
-            if(is_visited) {
-                ++number_of_robot_positions;
-            }
-        }
-    }
+    const std::vector<RestroomRobot> &robots, BitGrid &occupied,
+    BitGrid &has_neighbor) -> double {
+    mark_robot_positions(robots, occupied);
+    const std::size_t number_of_robot_positions = occupied.count();
 
     const std::vector<int> dx{-1, -1, -1, 0, 0, 1, 1, 1};
     const std::vector<int> dy{-1, 0, 1, -1, 1, -1, 0, 1};
 
-    int num_have_neighbors = 0;
-    for(std::size_t i = 0; i < visited.size(); ++i) {
-        for(std::size_t j = 0; j < visited[i].size(); ++j) {
-            if(!visited[i][j]) {
-                continue;
-            }
-
-            bool has_neighbors = false;
-            for(std::size_t k = 0; k < dx.size(); ++k) {
-                int dx1 = dx[k];
-                int dy1 = dy[k];
-
-                std::size_t neighbor_row =
-                    (i + static_cast<std::size_t>(BATHROOM_HEIGHT + dx1)) %
-                    BATHROOM_HEIGHT;
-                std::size_t neighbor_col =
-                    (j + static_cast<std::size_t>(BATHROOM_WIDTH + dy1)) %
-                    BATHROOM_WIDTH;
-
-                if(visited[neighbor_row][neighbor_col]) {
-                    has_neighbors = true;
-                    break;
-                }
-            }
-
-            if(has_neighbors) {
-                ++num_have_neighbors;
-            }
-        }
+    // a cell has a neighbor if some wrapped-around shift of the occupied
+    // cells lands on it
+    has_neighbor.clear();
+    for(std::size_t k = 0; k < dx.size(); ++k) {
+        has_neighbor.or_rotated(occupied, dx[k], dy[k]);
     }
+    const std::size_t num_have_neighbors = occupied.count_and(has_neighbor);
 
-    return num_have_neighbors / static_cast<double>(number_of_robot_positions);
+    return static_cast<double>(num_have_neighbors) /
+           static_cast<double>(number_of_robot_positions);
 }
 
 auto solve_day14a() -> int64_t {
@@ -190,8 +165,11 @@ auto solve_day14b() -> int64_t {
         restroom_robot.step(VERIFIED_SECONDS);
     }
 
+    BitGrid occupied(BATHROOM_HEIGHT, BATHROOM_WIDTH);
+    BitGrid has_neighbor(BATHROOM_HEIGHT, BATHROOM_WIDTH);
     int num_seconds = 1 + VERIFIED_SECONDS;
     while(num_seconds < MAX_SECONDS_TO_TRY) {
+        check_cancellation();
 
         if(num_seconds % LOGGING_FREQUENCY == 0) {
             std::cout << "num_seconds at " << num_seconds << std::endl;
@@ -203,7 +181,7 @@ auto solve_day14b() -> int64_t {
 
         const double percentage_have_neighbors =
             find_percentage_of_robot_positions_have_at_least_one_neighbor(
-                restroom_robots);
+                restroom_robots, occupied, has_neighbor);
         if(percentage_have_neighbors > NEIGHBOR_TOLERANCE) {
             std::cout << "On second " << num_seconds
                       << ", perentage of positions have neighbors: "
@@ -1,14 +1,15 @@
 #include <cstdint> // std::size_t
-#include <fstream> // std::ifstream
 #include <iostream>
 #include <map>
 #include <set>
+#include <sstream>   // std::istringstream
 #include <stdexcept> // std::invalid_argument, std::runtime_error
 #include <string>
 #include <utility> // std::pair, std::move
 #include <vector>
 
 #include "day.hpp"
+#include "utils.hpp"
 
 namespace Day15 {
 
@@ -22,7 +23,7 @@ constexpr char RIGHT_BOX_SYMBOL = ']';
 static auto parse_input()
     -> std::pair<std::vector<std::vector<char>>, std::string> {
     const std::string input_file_name{"data/day15.txt"};
-    std::ifstream input_file{input_file_name};
+    std::istringstream input_file = open_input(input_file_name);
 
     std::vector<std::vector<char>> board;
     std::string attempted_moves;
@@ -1,16 +1,17 @@
 #include <algorithm>  // std::min, std::replace
 #include <cstdint>    // std::size_t, int64_t
-#include <fstream>    // std::ifstream
 #include <functional> // std::greater
 #include <limits>     // std::numeric_limits
 #include <map>
 #include <queue> // std::priority_queue
 #include <set>
+#include <sstream> // std::istringstream
 #include <tuple>   // std::get
 #include <utility> // std::pair
 #include <vector>
 
 #include "day.hpp"
+#include "utils.hpp"
 
 namespace Day16 {
 
@@ -28,7 +29,7 @@ static auto parse_input() -> std::tuple<std::vector<std::vector<char>>,
                                         std::pair<std::size_t, std::size_t>,
                                         std::pair<std::size_t, std::size_t>> {
     const std::string input_file_name = "data/day16.txt";
-    std::ifstream input_file{input_file_name};
+    std::istringstream input_file = open_input(input_file_name);
 
     std::vector<std::vector<char>> board;
     std::pair<std::size_t, std::size_t> start_location(0, 0);
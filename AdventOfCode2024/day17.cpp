@@ -41,20 +41,21 @@ out register_a initial value from it.
 */
 
 #include <cstdint>   // std::size_t, int64_t
-#include <fstream>   // std::ifstream
 #include <iostream>  // std::cout, std::endl
+#include <sstream>   // std::istringstream
 #include <stdexcept> // std::invalid_argument
 #include <string>    // std::getline
 #include <tuple>     // std::get
 #include <vector>
 
 #include "day.hpp"
+#include "utils.hpp"
 
 namespace Day17 {
 
 auto parse_input() -> std::tuple<std::vector<int>, int64_t, int64_t, int64_t> {
     const std::string input_file_name = "data/day17.txt";
-    std::ifstream input_file{input_file_name};
+    std::istringstream input_file = open_input(input_file_name);
 
     std::vector<std::vector<char>> board;
     std::pair<std::size_t, std::size_t> start_location(0, 0);
@@ -1,6 +1,5 @@
 #include <algorithm> // std::min
 #include <cstdint>   // std::size_t, int64_t
-#include <fstream>   // std::ifstream
 #include <iostream>  // std::cout, std::endl
 #include <limits>    // std::numeric_limits
 #include <queue>
@@ -9,7 +8,9 @@
 #include <utility> // std::pair
 #include <vector>
 
+#include "bit_grid.hpp"
 #include "day.hpp"
+#include "utils.hpp"
 
 namespace Day18 {
 
@@ -18,7 +19,7 @@ constexpr std::size_t MAX_COLS = 71;
 
 auto parse_input() -> std::vector<std::pair<std::size_t, std::size_t>> {
     const std::string input_file_name = "data/day18.txt";
-    std::ifstream input_file{input_file_name};
+    std::istringstream input_file = open_input(input_file_name);
 
     std::vector<std::pair<std::size_t, std::size_t>> result;
     std::string line;
@@ -40,36 +41,33 @@ auto parse_input() -> std::vector<std::pair<std::size_t, std::size_t>> {
 
 auto get_is_obstacle(
     const std::vector<std::pair<std::size_t, std::size_t>> &obstacle_locations,
-    const std::size_t num_obstacles) -> std::vector<std::vector<bool>> {
-    std::vector<std::vector<bool>> is_obstacle(
-        MAX_ROWS, std::vector<bool>(MAX_COLS, false));
+    const std::size_t num_obstacles) -> BitGrid {
+    BitGrid is_obstacle(MAX_ROWS, MAX_COLS);
     for(std::size_t i = 0; i < num_obstacles; ++i) {
         const std::pair<std::size_t, std::size_t> position =
             obstacle_locations[i];
-        is_obstacle[position.first][position.second] = true;
+        is_obstacle.set(position.first, position.second);
     }
     return is_obstacle;
 }
 
-auto print_obstacles(const std::vector<std::vector<bool>> &is_obstacle)
-    -> void {
-    for(const std::vector<bool> &vec : is_obstacle) {
-        for(const bool b : vec) {
-            std::cout << (b ? '#' : '.');
+auto print_obstacles(const BitGrid &is_obstacle) -> void {
+    for(std::size_t i = 0; i < is_obstacle.num_rows(); ++i) {
+        for(std::size_t j = 0; j < is_obstacle.num_cols(); ++j) {
+            std::cout << (is_obstacle.test(i, j) ? '#' : '.');
         }
         std::cout << std::endl;
     }
 }
 
-auto bfs(const std::vector<std::vector<bool>> &is_obstacle,
+auto bfs(const BitGrid &is_obstacle,
          const std::pair<std::size_t, std::size_t> start_position,
          const std::pair<std::size_t, std::size_t> end_position)
     -> std::size_t {
     const std::vector<int> dx{1, 0, -1, 0};
     const std::vector<int> dy{0, 1, 0, -1};
 
-    std::vector<std::vector<bool>> visited(MAX_ROWS,
-                                           std::vector<bool>(MAX_COLS, false));
+    BitGrid visited(MAX_ROWS, MAX_COLS);
     std::vector<std::vector<std::size_t>> distances(
         MAX_ROWS, std::vector<std::size_t>(
                       MAX_COLS, std::numeric_limits<std::size_t>::max()));
@@ -82,10 +80,10 @@ auto bfs(const std::vector<std::vector<bool>> &is_obstacle,
         const std::pair<std::size_t, std::size_t> curr = q.front();
         q.pop();
 
-        if(visited[curr.first][curr.second]) {
+        if(visited.test(curr.first, curr.second)) {
             continue;
         }
-        visited[curr.first][curr.second] = true;
+        visited.set(curr.first, curr.second);
 
         for(std::size_t k = 0; k < dx.size(); ++k) {
             const int potential_next_row = static_cast<int>(curr.first) + dx[k];
@@ -99,8 +97,8 @@ auto bfs(const std::vector<std::vector<bool>> &is_obstacle,
                     static_cast<std::size_t>(potential_next_row);
                 const auto next_col =
                     static_cast<std::size_t>(potential_next_col);
-                if(!is_obstacle[next_row][next_col] &&
-                   !visited[next_row][next_col]) {
+                if(!is_obstacle.test(next_row, next_col) &&
+                   !visited.test(next_row, next_col)) {
                     distances[next_row][next_col] =
                         std::min(distances[curr.first][curr.second] + 1,
                                  distances[next_row][next_col]);
@@ -119,7 +117,7 @@ auto solve_day18a() -> int64_t {
     const std::vector<std::pair<std::size_t, std::size_t>> obstacles =
         Day18::parse_input();
     const std::size_t num_obstacles = 1024;
-    const std::vector<std::vector<bool>> is_obstacle =
+    const BitGrid is_obstacle =
         Day18::get_is_obstacle(obstacles, num_obstacles);
     return static_cast<int64_t>(
         Day18::bfs(is_obstacle, std::pair<std::size_t, std::size_t>(0, 0),
@@ -135,7 +133,7 @@ auto solve_day18b() -> int64_t {
     int high = static_cast<int>(obstacles.size());
     while(low <= high) {
         const int mid = (low + high) / 2;
-        const std::vector<std::vector<bool>> is_obstacle =
+        const BitGrid is_obstacle =
             Day18::get_is_obstacle(obstacles, static_cast<std::size_t>(mid));
         const std::size_t path_length =
             Day18::bfs(is_obstacle, std::pair<std::size_t, std::size_t>(0, 0),
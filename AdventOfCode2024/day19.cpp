@@ -1,11 +1,14 @@
-#include <cstdint> // std::size_t, int64_t
-#include <fstream> // std::ifstream
+#include <algorithm> // std::max
+#include <cstdint>   // std::size_t, int64_t
 #include <set>
+#include <sstream> // std::istringstream
 #include <string>  // std::getline
 #include <utility> // std::pair
 #include <vector>
 
 #include "day.hpp"
+#include "memo_cache.hpp"
+#include "utils.hpp"
 
 namespace Day19 {
 
@@ -25,7 +28,7 @@ auto split(const std::string &text, const std::string &pattern)
 auto parse_input()
     -> std::pair<std::vector<std::string>, std::vector<std::string>> {
     const std::string input_file_name = "data/day19.txt";
-    std::ifstream input_file{input_file_name};
+    std::istringstream input_file = open_input(input_file_name);
 
     std::string patterns_line;
     std::getline(input_file, patterns_line);
@@ -43,22 +46,48 @@ auto parse_input()
         patterns, desired);
 }
 
+/**
+ * Number of ways to build output[start..] from the patterns. ways_from_start
+ * memoizes by start position, so it must be cleared between outputs.
+ */
+auto count_ways_to_build_suffix(const std::string &output,
+                                const std::size_t start,
+                                const std::set<std::string> &patterns,
+                                const std::size_t max_pattern_size,
+                                MemoCache<1, int64_t> &ways_from_start)
+    -> int64_t {
+    if(start == output.size()) {
+        return 1;
+    }
+    return ways_from_start.get_or_compute(
+        {static_cast<int64_t>(start)}, [&]() -> int64_t {
+            int64_t ways = 0;
+            for(std::size_t size = 1;
+                size <= max_pattern_size && start + size <= output.size();
+                ++size) {
+                if(patterns.find(output.substr(start, size)) !=
+                   patterns.end()) {
+                    ways += count_ways_to_build_suffix(output, start + size,
+                                                       patterns,
+                                                       max_pattern_size,
+                                                       ways_from_start);
+                }
+            }
+            return ways;
+        });
+}
+
 auto count_num_ways_to_build_output_from_patterns(
     const std::string &output, const std::set<std::string> &patterns)
     -> int64_t {
-    std::vector<int64_t> dp(1 + output.size(), 0);
-    dp[0] = 1;
-
-    for(std::size_t end = 1; end < dp.size(); ++end) {
-        for(std::size_t mid = 0; mid < end; ++mid) {
-            const std::string sub = output.substr(mid, end - mid);
-            if(patterns.find(sub) != patterns.end()) {
-                dp[end] += dp[mid];
-            }
-        }
+    std::size_t max_pattern_size = 0;
+    for(const std::string &pattern : patterns) {
+        max_pattern_size = std::max(max_pattern_size, pattern.size());
     }
 
-    return dp[output.size()];
+    MemoCache<1, int64_t> ways_from_start;
+    return count_ways_to_build_suffix(output, 0, patterns, max_pattern_size,
+                                      ways_from_start);
 }
 
 } // namespace Day19
@@ -1,15 +1,17 @@
 #include <algorithm> // std::min, std::replace
 #include <cmath>     // std::abs
 #include <cstdint>   // std::size_t, int64_t
-#include <fstream>   // std::ifstream
 #include <limits>    // std::numeric_limits
 #include <queue>
+#include <sstream> // std::istringstream
 #include <string>  // std::getline
 #include <tuple>   // std::get
 #include <utility> // std::pair
 #include <vector>
 
+#include "bit_grid.hpp"
 #include "day.hpp"
+#include "utils.hpp"
 
 namespace Day20 {
 
@@ -22,7 +24,7 @@ auto parse_input() -> std::tuple<std::vector<std::vector<char>>,
                                  std::pair<std::size_t, std::size_t>,
                                  std::pair<std::size_t, std::size_t>> {
     const std::string input_file_name = "data/day20.txt";
-    std::ifstream input_file{input_file_name};
+    std::istringstream input_file = open_input(input_file_name);
 
     std::vector<std::vector<char>> board;
     std::pair<std::size_t, std::size_t> start_location(0, 0);
@@ -77,8 +79,7 @@ auto find_neighbors(const std::pair<std::size_t, std::size_t> location,
 auto bfs(const std::vector<std::vector<char>> &board,
          const std::pair<std::size_t, std::size_t> &start)
     -> std::vector<std::vector<std::size_t>> {
-    std::vector<std::vector<bool>> visited(
-        board.size(), std::vector<bool>(board[0].size(), false));
+    BitGrid visited(board.size(), board[0].size());
     std::vector<std::vector<std::size_t>> distances(
         board.size(),
         std::vector<std::size_t>(board[0].size(),
@@ -92,15 +93,15 @@ auto bfs(const std::vector<std::vector<char>> &board,
         const std::pair<std::size_t, std::size_t> curr = q.front();
         q.pop();
 
-        if(visited[curr.first][curr.second]) {
+        if(visited.test(curr.first, curr.second)) {
             continue;
         }
-        visited[curr.first][curr.second] = true;
+        visited.set(curr.first, curr.second);
 
         const std::vector<std::pair<std::size_t, std::size_t>> neighbors =
             find_neighbors(curr, board);
         for(const std::pair<std::size_t, std::size_t> &neighbor : neighbors) {
-            if(!visited[neighbor.first][neighbor.second]) {
+            if(!visited.test(neighbor.first, neighbor.second)) {
                 distances[neighbor.first][neighbor.second] =
                     std::min(1 + distances[curr.first][curr.second],
                              distances[neighbor.first][neighbor.second]);
@@ -1,14 +1,14 @@
 #include <cmath>    // std::abs
 #include <cstdint>  // std::size_t, int64_t
-#include <fstream>  // std::ifstream
 #include <iostream> // std::cout, std::endl
 #include <map>
-#include <sstream> // std::stringstream
+#include <sstream> // std::istringstream
 #include <string>  // std::getline, std::stoi
 #include <utility> // std::pair
 #include <vector>
 
 #include "day.hpp"
+#include "memo_cache.hpp"
 #include "utils.hpp" // split()
 
 namespace Day21 {
@@ -16,58 +16,9 @@ namespace Day21 {
 constexpr char ACCEPT_KEY = 'A';
 constexpr char UNKNOWN_KEY = '?';
 
-class PasscodeStepSummary {
-  public:
-    auto update_single(const std::string &substep, const int64_t count)
-        -> void {
-        this->substep_counts[substep] += count;
-    }
-
-    [[nodiscard]] auto get_single_count(const std::string &substep) const
-        -> int64_t {
-        return this->substep_counts.at(substep);
-    }
-
-    [[nodiscard]] auto get_all_substeps() const -> std::vector<std::string> {
-        std::vector<std::string> result;
-        for(const auto &substep_count : this->substep_counts) {
-            if(substep_count.second > 0) {
-                result.push_back(substep_count.first);
-            }
-        }
-
-        return result;
-    }
-
-    [[nodiscard]] auto num_steps() const -> int64_t {
-        int64_t total = 0;
-        for(const auto &substep_count : this->substep_counts) {
-            // plus one from implicit 'A' at the end of the substep.
-            // Ex: we store {"<<v": 3} to mean we saw "<<vA" 3 times
-            total += static_cast<int64_t>(substep_count.first.size() + 1) *
-                     substep_count.second;
-        }
-        return total;
-    }
-
-    [[nodiscard]] auto to_string() const -> std::string {
-        std::stringstream ss;
-        ss << "PasscodeStepSummary(" << '\n';
-        for(const auto &substep_count : this->substep_counts) {
-            ss << "\t[" << substep_count.first << "] -> "
-               << substep_count.second << "," << '\n';
-        }
-        ss << ")";
-        return ss.str();
-    }
-
-  private:
-    std::map<std::string, int64_t> substep_counts{};
-};
-
 auto parse_input() -> std::vector<std::string> {
     const std::string input_file_name = "data/day21.txt";
-    std::ifstream input_file{input_file_name};
+    std::istringstream input_file = open_input(input_file_name);
 
     std::vector<std::string> passcodes;
     std::string line;
@@ -197,6 +148,24 @@ auto navigate_keypad(const std::vector<std::string> &directional_keypad)
     return min_button_pushes_to_navigate_directional_keypad;
 }
 
+/**
+ * The keypads never change, so their move tables are built on first use and
+ * kept for every later solve (both parts, and re-solves in watch mode).
+ */
+auto get_numeric_keypad_directions()
+    -> const std::map<std::pair<char, char>, std::string> & {
+    static const std::map<std::pair<char, char>, std::string> directions =
+        navigate_keypad({"789", "456", "123", "?0A"});
+    return directions;
+}
+
+auto get_directional_keypad_directions()
+    -> const std::map<std::pair<char, char>, std::string> & {
+    static const std::map<std::pair<char, char>, std::string> directions =
+        navigate_keypad({"?^A", "<v>"});
+    return directions;
+}
+
 auto print_keypad_directions(
     const std::map<std::pair<char, char>, std::string> &keypad_directions)
     -> void {
@@ -221,86 +190,95 @@ auto step_one_layer_up(
     return steps;
 }
 
-auto summarize_one_layer_up(
-    const PasscodeStepSummary &initial_summary,
-    const std::map<std::pair<char, char>, std::string> &keypad_directions)
-    -> PasscodeStepSummary {
-    PasscodeStepSummary layer_up_summary;
-    for(const std::string &substep : initial_summary.get_all_substeps()) {
-        const int64_t substep_initial_count =
-            initial_summary.get_single_count(substep);
-        const std::string substep_layer_up =
-            step_one_layer_up(std::string(1, ACCEPT_KEY)
-                                  .append(substep)
-                                  .append(std::string(1, ACCEPT_KEY)),
-                              keypad_directions);
-
-        // std::cout << "substep " << substep << " -> " << substep_layer_up <<
-        // std::endl;
-        const std::vector<std::string> substep_layer_up_substeps =
-            split(substep_layer_up, ACCEPT_KEY);
-        // split("vAvA", 'A') returns ["v", "v", ""].
-        // We only want to count "" for instances like "AA", not because of the
-        // last split.
-        for(std::size_t i = 0; i + 1 < substep_layer_up_substeps.size(); ++i) {
-            const std::string substep_layer_up_substep =
-                substep_layer_up_substeps[i];
-            layer_up_summary.update_single(substep_layer_up_substep,
-                                           substep_initial_count);
-        }
+/**
+ * Substeps on a directional keypad are short strings over "<>^v". Pack one
+ * into an integer memo key: base 5 with digits 1-4, so that strings of
+ * different lengths never collide.
+ */
+auto encode_substep(const std::string &substep) -> int64_t {
+    constexpr const int64_t BASE = 5;
+    const std::string directional_keys = "<>^v";
+
+    int64_t code = 0;
+    for(const char key : substep) {
+        code = BASE * code + 1 +
+               static_cast<int64_t>(directional_keys.find(key));
     }
-
-    return layer_up_summary;
+    return code;
 }
 
-auto step_summaries_to_enter_passcodes(
-    const std::vector<std::string> &passcodes, const int num_robots)
-    -> std::vector<PasscodeStepSummary> {
-    const std::vector<std::string> numeric_keypad{"789", "456", "123", "?0A"};
-    const std::vector<std::string> directional_keypad{"?^A", "<v>"};
-    const std::map<std::pair<char, char>, std::string>
-        numeric_keypad_directions = Day21::navigate_keypad(numeric_keypad);
-    const std::map<std::pair<char, char>, std::string>
-        directional_keypad_directions =
-            Day21::navigate_keypad(directional_keypad);
+auto count_directional_presses(const std::string &substep, int num_layers)
+    -> int64_t;
 
-    print_keypad_directions(numeric_keypad_directions);
-    std::cout << "====================================" << std::endl;
-    print_keypad_directions(directional_keypad_directions);
-
-    std::vector<PasscodeStepSummary> step_summary_for_each_passcode;
+/**
+ * Presses needed at the outermost keypad to type substep followed by 'A' on
+ * a keypad with the given directions, which is operated through num_layers
+ * directional keypads (num_layers >= 1).
+ */
+auto count_presses_through_layers(
+    const std::string &substep,
+    const std::map<std::pair<char, char>, std::string> &keypad_directions,
+    const int num_layers) -> int64_t {
+    // each robot starts at button A, and is back on A after every substep
+    const std::string substep_layer_up =
+        step_one_layer_up(std::string(1, ACCEPT_KEY)
+                              .append(substep)
+                              .append(std::string(1, ACCEPT_KEY)),
+                          keypad_directions);
+
+    const std::vector<std::string> substep_layer_up_substeps =
+        split(substep_layer_up, ACCEPT_KEY);
+    // split("vAvA", 'A') returns ["v", "v", ""].
+    // We only want to count "" for instances like "AA", not because of the
+    // last split.
+    int64_t presses = 0;
+    for(std::size_t i = 0; i + 1 < substep_layer_up_substeps.size(); ++i) {
+        presses += count_directional_presses(substep_layer_up_substeps[i],
+                                             num_layers - 1);
+    }
 
-    for(const std::string &passcode : passcodes) {
-        PasscodeStepSummary summary;
-        summary.update_single(passcode.substr(0, passcode.size() - 1), 1);
-        std::cout << "Start with passcode " << passcode << std::endl;
-        for(int i = 0; i < num_robots; ++i) {
-            // each robot starts at button A.
-            // robot closest to Historian has numeric keypad; everyone else has
-            // directional keypad
-            summary = summarize_one_layer_up(
-                summary, (i == 0) ? numeric_keypad_directions
-                                  : directional_keypad_directions);
-            // std::cout << "Robot[" << 1 + i << "]: " << std::endl;
-            // std::cout << summary.to_string() << std::endl;
-            // std::cout << "with num_chars = " << summary.num_steps() <<
-            // std::endl;
-        }
+    return presses;
+}
 
-        step_summary_for_each_passcode.push_back(summary);
+/**
+ * Presses needed to type substep followed by 'A' on a directional keypad
+ * operated through num_layers more directional keypads. This depends on
+ * nothing but its arguments, so one memo serves every passcode, both parts
+ * and every input.
+ */
+auto count_directional_presses(const std::string &substep,
+                               const int num_layers) -> int64_t {
+    static MemoCache<2, int64_t> presses_per_substep;
+
+    if(num_layers == 0) {
+        // plus one for the implicit 'A' at the end of the substep
+        return static_cast<int64_t>(substep.size()) + 1;
     }
-
-    return step_summary_for_each_passcode;
+    return presses_per_substep.get_or_compute(
+        {encode_substep(substep), num_layers}, [&]() -> int64_t {
+            return count_presses_through_layers(
+                substep, get_directional_keypad_directions(), num_layers);
+        });
 }
 
 auto compute_total_complexity(const std::vector<std::string> &passcodes,
-                              const std::vector<PasscodeStepSummary> &summaries)
-    -> int64_t {
+                              const int num_robots) -> int64_t {
+    const std::map<std::pair<char, char>, std::string>
+        &numeric_keypad_directions = get_numeric_keypad_directions();
+
+    print_keypad_directions(numeric_keypad_directions);
+    std::cout << "====================================" << std::endl;
+    print_keypad_directions(get_directional_keypad_directions());
+
     int64_t total_complexity = 0;
-    for(std::size_t i = 0; i < passcodes.size(); ++i) {
-        const std::string passcode = passcodes[i];
-        total_complexity += summaries[i].num_steps() *
-                            std::stoi(passcode.substr(0, passcode.size() - 1));
+    for(const std::string &passcode : passcodes) {
+        std::cout << "Start with passcode " << passcode << std::endl;
+        // robot closest to Historian has numeric keypad; everyone else has
+        // directional keypad
+        const std::string digits = passcode.substr(0, passcode.size() - 1);
+        total_complexity += count_presses_through_layers(
+                                digits, numeric_keypad_directions, num_robots) *
+                            std::stoi(digits);
     }
 
     return total_complexity;
@@ -311,17 +289,13 @@ auto compute_total_complexity(const std::vector<std::string> &passcodes,
 auto solve_day21a() -> int64_t {
     const std::vector<std::string> passcodes = Day21::parse_input();
     const int num_robots = 3;
-    const std::vector<Day21::PasscodeStepSummary> passcodes_summaries =
-        Day21::step_summaries_to_enter_passcodes(passcodes, num_robots);
-    return Day21::compute_total_complexity(passcodes, passcodes_summaries);
+    return Day21::compute_total_complexity(passcodes, num_robots);
 }
 
 auto solve_day21b() -> int64_t {
     const std::vector<std::string> passcodes = Day21::parse_input();
     const int num_robots = 26;
-    const std::vector<Day21::PasscodeStepSummary> passcodes_summaries =
-        Day21::step_summaries_to_enter_passcodes(passcodes, num_robots);
-    return Day21::compute_total_complexity(passcodes, passcodes_summaries);
+    return Day21::compute_total_complexity(passcodes, num_robots);
 }
 
 /**
@@ -330,4 +304,4 @@ Now steps[12] = <A^A^^>AvvvA
 Now steps[28] = v<<A>>^A<A>A<AAv>A^A<vAAA^>A
 Now steps[68] =
 <vA<AA>>^AvAA<^A>Av<<A>>^AvA^Av<<A>>^AA<vA>A^A<A>Av<<A>A^>AAA<Av>A^A
-*/
\ No newline at end of file
+*/
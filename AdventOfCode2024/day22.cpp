@@ -1,13 +1,13 @@
 #include <algorithm> // std::max
 #include <cstdint>   // std::size_t, int64_t
-#include <fstream>   // std::ifstream
-#include <map>
-#include <set>
-#include <string> // std::getline, std::stoi
-#include <tuple>  // std::get
+#include <initializer_list>
+#include <sstream> // std::istringstream
+#include <string>  // std::getline, std::stoi
 #include <vector>
 
 #include "day.hpp"
+#include "flat_hash_map.hpp"
+#include "utils.hpp"
 
 namespace Day22 {
 
@@ -18,7 +18,7 @@ const int64_t MULTIPLY2_SCALAR = 2048;
 
 auto parse_input() -> std::vector<int64_t> {
     const std::string input_file_name = "data/day22.txt";
-    std::ifstream input_file{input_file_name};
+    std::istringstream input_file = open_input(input_file_name);
 
     std::vector<int64_t> secret_numbers;
     std::string line;
@@ -57,6 +57,21 @@ auto generate_prices(const int64_t initial_secret_number) -> std::vector<int> {
     return prices;
 }
 
+/**
+ * Price changes are in [-9, 9], so four of them pack into one base-19 integer.
+ */
+[[gnu::const]] auto encode_sequence(const int change1, const int change2,
+                                    const int change3, const int change4)
+    -> int {
+    constexpr const int MAX_CHANGE = 9;
+    constexpr const int NUM_CHANGES = 2 * MAX_CHANGE + 1;
+    int code = 0;
+    for(const int change : {change1, change2, change3, change4}) {
+        code = code * NUM_CHANGES + (change + MAX_CHANGE);
+    }
+    return code;
+}
+
 auto calculate_best_num_bananas(
     const std::vector<int64_t> &initial_secret_numbers) -> int64_t {
     std::vector<std::vector<int>> prices_of_vendors(
@@ -66,16 +81,17 @@ auto calculate_best_num_bananas(
     }
 
     const std::size_t sequence_length = 4;
-    std::map<std::tuple<int, int, int, int>, int> sequence_to_total_bananas;
+    FlatHashMap<int, int> sequence_to_total_bananas;
+    FlatHashMap<int, bool> seen_sequences;
     for(const std::vector<int> &prices : prices_of_vendors) {
-        std::set<std::tuple<int, int, int, int>> seen_sequences;
+        seen_sequences.clear();
         for(std::size_t i = 0; i + sequence_length < prices.size(); ++i) {
             const int num_bananas_at_sell = prices[i + sequence_length];
-            const std::tuple<int, int, int, int> sequence(
+            const int sequence = encode_sequence(
                 prices[i + 1] - prices[i], prices[i + 2] - prices[i + 1],
                 prices[i + 3] - prices[i + 2], prices[i + 4] - prices[i + 3]);
-            if(seen_sequences.find(sequence) == seen_sequences.end()) {
-                seen_sequences.insert(sequence);
+            if(seen_sequences.find(sequence) == nullptr) {
+                seen_sequences[sequence] = true;
                 sequence_to_total_bananas[sequence] += num_bananas_at_sell;
             }
         }
@@ -83,7 +99,7 @@ auto calculate_best_num_bananas(
 
     int best_number_of_bananas = 0;
     for(const auto &seq : sequence_to_total_bananas) {
-        best_number_of_bananas = std::max(seq.second, best_number_of_bananas);
+        best_number_of_bananas = std::max(seq.value, best_number_of_bananas);
     }
 
     return best_number_of_bananas;
@@ -1,69 +1,81 @@
-#include <algorithm> // std::set_intersection, std::sort
+#include <algorithm> // std::sort
 #include <cstdint>   // std::size_t, int64_t
-#include <fstream>   // std::ifstream
 #include <iostream>  // std::cout, std::endl
-#include <iterator>  // std::inserter
-#include <map>
 #include <set>
+#include <span>
+#include <sstream> // std::istringstream
 #include <string>  // std::getline
-#include <utility> // std::pair
+#include <utility> // std::move
 #include <vector>
 
+#include "cancellation.hpp"
 #include "day.hpp"
+#include "graph.hpp"
 #include "utils.hpp" // split()
 
 namespace Day23 {
 
-auto parse_input() -> std::vector<std::pair<std::string, std::string>> {
+struct Network {
+    Network(Interner<std::string> computers_, CsrGraph connections_);
+    Network(const Network &other);
+    Network(Network &&other) noexcept;
+    auto operator=(const Network &other) -> Network &;
+    auto operator=(Network &&other) noexcept -> Network &;
+    ~Network();
+
+    Interner<std::string> computers;
+    // undirected: every connection is stored in both directions
+    CsrGraph connections;
+};
+
+Network::Network(Interner<std::string> computers_, CsrGraph connections_)
+    : computers(std::move(computers_)), connections(std::move(connections_)) {}
+Network::Network(const Network &other) = default;
+Network::Network(Network &&other) noexcept = default;
+auto Network::operator=(const Network &other) -> Network & = default;
+auto Network::operator=(Network &&other) noexcept -> Network & = default;
+Network::~Network() = default;
+
+auto parse_input() -> Network {
     const std::string input_file_name = "data/day23.txt";
-    std::ifstream input_file{input_file_name};
+    std::istringstream input_file = open_input(input_file_name);
 
-    std::vector<std::pair<std::string, std::string>> results;
+    Interner<std::string> computers;
+    std::vector<CsrGraph::Edge> edges;
     std::string line;
     while(std::getline(input_file, line)) {
         const std::vector<std::string> parts = split(line, '-');
-        results.emplace_back(parts[0], parts[1]);
+        const std::size_t first = computers.intern(parts[0]);
+        const std::size_t second = computers.intern(parts[1]);
+        edges.emplace_back(first, second);
+        edges.emplace_back(second, first);
     }
 
-    return results;
+    CsrGraph connections(computers.size(), edges);
+    return Network{std::move(computers), std::move(connections)};
 }
 
-auto generate_edges(
-    const std::vector<std::pair<std::string, std::string>> &connections)
-    -> std::map<std::string, std::set<std::string>> {
-    std::map<std::string, std::set<std::string>> edges;
-    for(const std::pair<std::string, std::string> &connection : connections) {
-        edges[connection.first].insert(connection.second);
-        edges[connection.second].insert(connection.first);
-    }
-
-    return edges;
-}
-
-auto find_all_triangles(
-    const std::vector<std::pair<std::string, std::string>> &connections)
-    -> std::vector<std::vector<std::string>> {
-    std::vector<std::vector<std::string>> triangles;
-    const std::map<std::string, std::set<std::string>> edges =
-        generate_edges(connections);
-    for(const auto &edge1 : edges) {
-        const std::string first = edge1.first;
-        const std::set<std::string> neighbors = edge1.second;
-        for(const std::string &second : neighbors) {
+/**
+ * Every triangle once, as ids in increasing order.
+ */
+auto find_all_triangles(const CsrGraph &connections)
+    -> std::vector<std::vector<std::size_t>> {
+    std::vector<std::vector<std::size_t>> triangles;
+    for(std::size_t first = 0; first < connections.num_nodes(); ++first) {
+        const std::span<const std::size_t> neighbors =
+            connections.neighbors(first);
+        for(const std::size_t second : neighbors) {
             if(first >= second) {
                 continue;
             }
-            const std::set<std::string> &second_neighbors = edges.at(second);
-            std::set<std::string> thirds;
-            std::set_intersection(
-                neighbors.begin(), neighbors.end(), second_neighbors.begin(),
-                second_neighbors.end(), std::inserter(thirds, thirds.begin()));
-            for(const std::string &third : thirds) {
+            const std::vector<std::size_t> thirds =
+                sorted_intersection(neighbors, connections.neighbors(second));
+            for(const std::size_t third : thirds) {
                 if(second >= third) {
                     continue;
                 }
                 triangles.push_back(
-                    std::vector<std::string>{first, second, third});
+                    std::vector<std::size_t>{first, second, third});
             }
         }
     }
@@ -72,27 +84,21 @@ auto find_all_triangles(
 }
 
 auto grow_tightly_coupled_computers(
-    const std::vector<std::string> &current_tightly_coupled_computers,
-    const std::map<std::string, std::set<std::string>> &edges)
-    -> std::vector<std::vector<std::string>> {
-    std::vector<std::vector<std::string>> next_tightly_coupled_computers;
-    std::set<std::string> common_neighbors =
-        edges.at(current_tightly_coupled_computers[0]);
-    for(const std::string &current_computer :
+    const std::vector<std::size_t> &current_tightly_coupled_computers,
+    const CsrGraph &connections) -> std::vector<std::vector<std::size_t>> {
+    std::vector<std::vector<std::size_t>> next_tightly_coupled_computers;
+    const std::span<const std::size_t> first_neighbors =
+        connections.neighbors(current_tightly_coupled_computers[0]);
+    std::vector<std::size_t> common_neighbors(first_neighbors.begin(),
+                                              first_neighbors.end());
+    for(const std::size_t current_computer :
         current_tightly_coupled_computers) {
-        const std::set<std::string> &current_computer_neighbors =
-            edges.at(current_computer);
-        std::set<std::string> intersection;
-        std::set_intersection(
-            common_neighbors.begin(), common_neighbors.end(),
-            current_computer_neighbors.begin(),
-            current_computer_neighbors.end(),
-            std::inserter(intersection, intersection.begin()));
-        common_neighbors = intersection;
+        common_neighbors = sorted_intersection(
+            common_neighbors, connections.neighbors(current_computer));
     }
 
-    for(const std::string &common_neighbor : common_neighbors) {
-        std::vector<std::string> next_tightly_coupled_computer =
+    for(const std::size_t common_neighbor : common_neighbors) {
+        std::vector<std::size_t> next_tightly_coupled_computer =
             current_tightly_coupled_computers;
         next_tightly_coupled_computer.push_back(common_neighbor);
         std::sort(next_tightly_coupled_computer.begin(),
@@ -103,26 +109,27 @@ auto grow_tightly_coupled_computers(
     return next_tightly_coupled_computers;
 }
 
-auto find_biggest_tightly_coupled_computers(
-    const std::vector<std::pair<std::string, std::string>> &connections)
-    -> std::set<std::vector<std::string>> {
-    const std::map<std::string, std::set<std::string>> edges =
-        generate_edges(connections);
-
-    std::set<std::vector<std::string>> current_tightly_coupled_computers;
-    for(const std::pair<std::string, std::string> &connection : connections) {
-        current_tightly_coupled_computers.insert(
-            std::vector<std::string>{connection.first, connection.second});
+auto find_biggest_tightly_coupled_computers(const CsrGraph &connections)
+    -> std::set<std::vector<std::size_t>> {
+    std::set<std::vector<std::size_t>> current_tightly_coupled_computers;
+    for(std::size_t first = 0; first < connections.num_nodes(); ++first) {
+        for(const std::size_t second : connections.neighbors(first)) {
+            if(first < second) {
+                current_tightly_coupled_computers.insert(
+                    std::vector<std::size_t>{first, second});
+            }
+        }
     }
-    std::set<std::vector<std::string>> next_tightly_coupled_computers;
+    std::set<std::vector<std::size_t>> next_tightly_coupled_computers;
     bool has_next = true;
 
     while(has_next) {
-        for(const std::vector<std::string> &tightly_coupled_computers :
+        for(const std::vector<std::size_t> &tightly_coupled_computers :
             current_tightly_coupled_computers) {
-            const std::vector<std::vector<std::string>> next =
+            check_cancellation();
+            const std::vector<std::vector<std::size_t>> next =
                 grow_tightly_coupled_computers(tightly_coupled_computers,
-                                               edges);
+                                               connections);
             next_tightly_coupled_computers.insert(next.begin(), next.end());
         }
         has_next = !next_tightly_coupled_computers.empty();
@@ -139,14 +146,17 @@ auto find_biggest_tightly_coupled_computers(
     return current_tightly_coupled_computers;
 }
 
-auto get_password(std::vector<std::string> tightly_coupled_computers)
-    -> std::string {
-    std::sort(tightly_coupled_computers.begin(),
-              tightly_coupled_computers.end());
+auto get_password(const std::vector<std::size_t> &tightly_coupled_computers,
+                  const Interner<std::string> &computers) -> std::string {
+    std::vector<std::string> names;
+    for(const std::size_t computer : tightly_coupled_computers) {
+        names.push_back(computers.name(computer));
+    }
+    std::sort(names.begin(), names.end());
     std::string password;
-    for(std::size_t i = 0; i < tightly_coupled_computers.size(); ++i) {
-        password += tightly_coupled_computers[i];
-        if(i + 1 < tightly_coupled_computers.size()) {
+    for(std::size_t i = 0; i < names.size(); ++i) {
+        password += names[i];
+        if(i + 1 < names.size()) {
             password += ',';
         }
     }
@@ -157,15 +167,14 @@ auto get_password(std::vector<std::string> tightly_coupled_computers)
 } // namespace Day23
 
 auto solve_day23a() -> int64_t {
-    const std::vector<std::pair<std::string, std::string>> connections =
-        Day23::parse_input();
-    const std::vector<std::vector<std::string>> triangles =
-        Day23::find_all_triangles(connections);
+    const Day23::Network network = Day23::parse_input();
+    const std::vector<std::vector<std::size_t>> triangles =
+        Day23::find_all_triangles(network.connections);
     int64_t count = 0;
-    for(const std::vector<std::string> &triangle : triangles) {
+    for(const std::vector<std::size_t> &triangle : triangles) {
         bool starts_with_t = false;
-        for(const std::string &computer_name : triangle) {
-            if(computer_name[0] == 't') {
+        for(const std::size_t computer : triangle) {
+            if(network.computers.name(computer)[0] == 't') {
                 starts_with_t = true;
                 break;
             }
@@ -178,15 +187,15 @@ auto solve_day23a() -> int64_t {
 }
 
 auto solve_day23b() -> int64_t {
-    const std::vector<std::pair<std::string, std::string>> connections =
-        Day23::parse_input();
-    const std::set<std::vector<std::string>> biggest_tightly_coupled_computers =
-        Day23::find_biggest_tightly_coupled_computers(connections);
+    const Day23::Network network = Day23::parse_input();
+    const std::set<std::vector<std::size_t>> biggest_tightly_coupled_computers =
+        Day23::find_biggest_tightly_coupled_computers(network.connections);
 
-    for(const std::vector<std::string> &tightly_coupled_computers :
+    for(const std::vector<std::size_t> &tightly_coupled_computers :
         biggest_tightly_coupled_computers) {
-        std::cout << Day23::get_password(tightly_coupled_computers)
+        std::cout << Day23::get_password(tightly_coupled_computers,
+                                         network.computers)
                   << std::endl;
     }
     return 0;
-}
\ No newline at end of file
+}
@@ -1,26 +1,72 @@
 #include <algorithm> // std::sort
 #include <cstdint>   // std::size_t, int64_t
-#include <fstream>   // std::ifstream
-#include <map>
+#include <span>
+#include <sstream> // std::istringstream
+#include <stdexcept> // std::invalid_argument
 #include <string>  // std::getline
-#include <tuple>   // std::get
-#include <utility> // std::pair
+#include <utility> // std::move, std::pair
 #include <vector>
 
 #include "day.hpp"
+#include "graph.hpp"
 #include "utils.hpp" // split()
 
 namespace Day24 {
 
-auto parse_input() -> std::pair<
-    std::map<std::string, bool>,
-    std::map<std::string, std::tuple<std::string, std::string, std::string>>> {
+enum class Operation { NONE, AND, OR, XOR };
+
+struct Circuit {
+    Circuit(Interner<std::string> wires_, CsrGraph gate_inputs_,
+            std::vector<Operation> gate_operations_,
+            std::vector<int> initial_values_);
+    Circuit(const Circuit &other);
+    Circuit(Circuit &&other) noexcept;
+    auto operator=(const Circuit &other) -> Circuit &;
+    auto operator=(Circuit &&other) noexcept -> Circuit &;
+    ~Circuit();
+
+    Interner<std::string> wires;
+    // wire -> the two wires feeding the gate that drives it
+    CsrGraph gate_inputs;
+    // per wire; NONE for the input wires, which are not driven by a gate
+    std::vector<Operation> gate_operations;
+    // per wire; -1 if not an input wire
+    std::vector<int> initial_values;
+};
+
+Circuit::Circuit(Interner<std::string> wires_, CsrGraph gate_inputs_,
+                 std::vector<Operation> gate_operations_,
+                 std::vector<int> initial_values_)
+    : wires(std::move(wires_)), gate_inputs(std::move(gate_inputs_)),
+      gate_operations(std::move(gate_operations_)),
+      initial_values(std::move(initial_values_)) {}
+Circuit::Circuit(const Circuit &other) = default;
+Circuit::Circuit(Circuit &&other) noexcept = default;
+auto Circuit::operator=(const Circuit &other) -> Circuit & = default;
+auto Circuit::operator=(Circuit &&other) noexcept -> Circuit & = default;
+Circuit::~Circuit() = default;
+
+[[gnu::pure]] auto parse_operation(const std::string &op_name) -> Operation {
+    if(op_name == "AND") {
+        return Operation::AND;
+    }
+    if(op_name == "OR") {
+        return Operation::OR;
+    }
+    if(op_name == "XOR") {
+        return Operation::XOR;
+    }
+    return Operation::NONE;
+}
+
+auto parse_input() -> Circuit {
     const std::string input_file_name = "data/day24.txt";
-    std::ifstream input_file{input_file_name};
+    std::istringstream input_file = open_input(input_file_name);
 
-    std::map<std::string, bool> initial_values;
-    std::map<std::string, std::tuple<std::string, std::string, std::string>>
-        gates;
+    Interner<std::string> wires;
+    std::vector<std::pair<std::size_t, int>> initial_values;
+    std::vector<std::pair<std::size_t, Operation>> operations;
+    std::vector<CsrGraph::Edge> edges;
 
     std::string line;
     bool first_part = true;
@@ -31,88 +77,111 @@ auto parse_input() -> std::pair<
         }
         if(first_part) {
             const std::string name = line.substr(0, 3);
-            const bool value = (line.substr(line.size() - 1, 1) == "1");
-            initial_values[name] = value;
+            const int value = (line.substr(line.size() - 1, 1) == "1") ? 1 : 0;
+            initial_values.emplace_back(wires.intern(name), value);
         } else {
             const std::vector<std::string> parts = split(line, ' ');
-            gates[parts[4]] = std::tuple<std::string, std::string, std::string>(
-                parts[0], parts[1], parts[2]);
+            const std::size_t output = wires.intern(parts[4]);
+            edges.emplace_back(output, wires.intern(parts[0]));
+            edges.emplace_back(output, wires.intern(parts[2]));
+            operations.emplace_back(output, parse_operation(parts[1]));
         }
     }
 
-    return std::pair<std::map<std::string, bool>,
-                     std::map<std::string, std::tuple<std::string, std::string,
-                                                      std::string>>>(
-        initial_values, gates);
+    std::vector<Operation> gate_operations(wires.size(), Operation::NONE);
+    for(const auto &[wire, operation] : operations) {
+        gate_operations[wire] = operation;
+    }
+    std::vector<int> wire_values(wires.size(), -1);
+    for(const auto &[wire, value] : initial_values) {
+        wire_values[wire] = value;
+    }
+    CsrGraph gate_inputs(wires.size(), edges);
+    return Circuit{std::move(wires), std::move(gate_inputs),
+                   std::move(gate_operations), std::move(wire_values)};
 }
 
-auto compute_all_values(
-    const std::map<std::string, bool> &initial_values,
-    const std::map<std::string,
-                   std::tuple<std::string, std::string, std::string>> &gates)
-    -> std::map<std::string, bool> {
-    std::map<std::string, bool> known_values(initial_values.begin(),
-                                             initial_values.end());
-
-    std::vector<std::string> stack(gates.size());
-    std::size_t index = 0;
-    for(const auto &gate : gates) {
-        stack[index] = gate.first;
-        ++index;
+enum class WireState : unsigned char { UNVISITED, ON_STACK, DONE };
+
+/**
+ * Value of every wire (0 or 1), or -1 for a wire that cannot be computed
+ * because it, or a wire feeding it, has neither a gate nor an initial value.
+ * Throws std::invalid_argument if the gates form a cycle.
+ */
+auto compute_all_values(const Circuit &circuit) -> std::vector<int> {
+    std::vector<int> known_values = circuit.initial_values;
+    // wires without a gate are never pushed; their value is already final
+    std::vector<WireState> states(circuit.wires.size(), WireState::UNVISITED);
+
+    std::vector<std::size_t> stack;
+    for(std::size_t wire = 0; wire < circuit.wires.size(); ++wire) {
+        if(circuit.gate_operations[wire] != Operation::NONE) {
+            stack.push_back(wire);
+        }
     }
 
     while(!stack.empty()) {
-        const std::string curr = stack.back();
-        if(known_values.find(curr) != known_values.end()) {
+        const std::size_t curr = stack.back();
+        if(states[curr] == WireState::DONE) {
             stack.pop_back();
             continue;
         }
-        bool children_known = true;
-        const std::string &child1 = std::get<0>(gates.at(curr));
-        const std::string &op_name = std::get<1>(gates.at(curr));
-        const std::string &child2 = std::get<2>(gates.at(curr));
-        if(known_values.find(child1) == known_values.end()) {
-            children_known = false;
-            stack.push_back(child1);
-        }
-        if(known_values.find(child2) == known_values.end()) {
-            children_known = false;
-            stack.push_back(child2);
-        }
-        if(!children_known) {
+        const std::span<const std::size_t> children =
+            circuit.gate_inputs.neighbors(curr);
+        if(states[curr] == WireState::UNVISITED) {
+            // the ON_STACK wires are exactly the ones on the current path
+            states[curr] = WireState::ON_STACK;
+            for(const std::size_t child : children) {
+                if(circuit.gate_operations[child] == Operation::NONE) {
+                    continue;
+                }
+                if(states[child] == WireState::ON_STACK) {
+                    throw std::invalid_argument(
+                        "Day 24 circuit has a cycle through wire " +
+                        circuit.wires.name(child));
+                }
+                if(states[child] == WireState::UNVISITED) {
+                    stack.push_back(child);
+                }
+            }
             continue;
         }
 
-        const bool operand1 = known_values.at(child1);
-        const bool operand2 = known_values.at(child2);
-        bool result = false;
-        if(op_name == "AND") {
-            result = operand1 && operand2;
-        } else if(op_name == "OR") {
-            result = operand1 || operand2;
-        } else if(op_name == "XOR") {
-            result = operand1 ^ operand2;
+        // every gate input is final now
+        const int operand1 = known_values[children[0]];
+        const int operand2 = known_values[children[1]];
+        int result = -1;
+        if(operand1 >= 0 && operand2 >= 0) {
+            switch(circuit.gate_operations[curr]) {
+            case Operation::AND:
+                result = operand1 & operand2;
+                break;
+            case Operation::OR:
+                result = operand1 | operand2;
+                break;
+            case Operation::XOR:
+                result = operand1 ^ operand2;
+                break;
+            case Operation::NONE:
+            default:
+                break;
+            }
         }
         known_values[curr] = result;
+        states[curr] = WireState::DONE;
         stack.pop_back();
     }
 
     return known_values;
 }
 
-auto compute_number(
-    const std::map<std::string, bool> &initial_values,
-    const std::map<std::string,
-                   std::tuple<std::string, std::string, std::string>> &gates)
-    -> int64_t {
-    const std::map<std::string, bool> known_values =
-        compute_all_values(initial_values, gates);
-    std::vector<std::pair<std::string, bool>> z_values;
-    for(const auto &known_value : known_values) {
-        const std::string gate_name = known_value.first;
-        const bool value = known_value.second;
-        if(gate_name[0] == 'z') {
-            z_values.emplace_back(gate_name, value);
+auto compute_number(const Circuit &circuit) -> int64_t {
+    const std::vector<int> known_values = compute_all_values(circuit);
+    std::vector<std::pair<std::string, int>> z_values;
+    for(std::size_t wire = 0; wire < circuit.wires.size(); ++wire) {
+        const std::string &wire_name = circuit.wires.name(wire);
+        if(wire_name[0] == 'z') {
+            z_values.emplace_back(wire_name, known_values[wire]);
         }
     }
 
@@ -120,7 +189,7 @@ auto compute_number(
 
     int64_t num = 0;
     for(auto it = z_values.rbegin(); it != z_values.rend(); ++it) {
-        num = 2 * num + ((it->second) ? 1 : 0);
+        num = 2 * num + ((it->second == 1) ? 1 : 0);
     }
 
     return num;
@@ -129,15 +198,8 @@ auto compute_number(
 } // namespace Day24
 
 auto solve_day24a() -> int64_t {
-    const std::pair<std::map<std::string, bool>,
-                    std::map<std::string,
-                             std::tuple<std::string, std::string, std::string>>>
-        inputs = Day24::parse_input();
-    const std::map<std::string, bool> initial_values = inputs.first;
-    const std::map<std::string,
-                   std::tuple<std::string, std::string, std::string>>
-        gates = inputs.second;
-    return Day24::compute_number(initial_values, gates);
+    const Day24::Circuit circuit = Day24::parse_input();
+    return Day24::compute_number(circuit);
 }
 
-auto solve_day24b() -> int64_t { return 0; }
\ No newline at end of file
+auto solve_day24b() -> int64_t { return 0; }
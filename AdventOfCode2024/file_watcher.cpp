@@ -0,0 +1,80 @@
+#include <array>
+#include <cstddef>
+#include <cstring> // std::memcpy
+#include <string>
+
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h> // read, close
+
+#include "file_watcher.hpp"
+
+FileWatcher::FileWatcher(const std::string &file_name)
+    : inotify_fd(inotify_init1(IN_CLOEXEC)) {
+    const std::size_t slash = file_name.rfind('/');
+    const std::string directory =
+        (slash == std::string::npos) ? "." : file_name.substr(0, slash);
+    base_name = (slash == std::string::npos) ? file_name
+                                             : file_name.substr(slash + 1);
+    if(inotify_fd >= 0) {
+        watch_descriptor =
+            inotify_add_watch(inotify_fd, directory.c_str(),
+                              IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+    }
+}
+
+FileWatcher::~FileWatcher() {
+    if(inotify_fd >= 0) {
+        close(inotify_fd);
+    }
+}
+
+/**
+ * Read whatever events arrive within the timeout (-1 waits forever). Returns
+ * how many of them were about the watched file, or -1 on error.
+ */
+auto FileWatcher::read_events(const int timeout_milliseconds) -> int {
+    pollfd poll_fd{inotify_fd, POLLIN, 0};
+    const int ready = poll(&poll_fd, 1, timeout_milliseconds);
+    if(ready <= 0) {
+        return ready;
+    }
+
+    alignas(inotify_event) std::array<char, 4096> buffer{};
+    const ssize_t length = read(inotify_fd, buffer.data(), buffer.size());
+    if(length <= 0) {
+        return -1;
+    }
+
+    int num_matching = 0;
+    std::size_t offset = 0;
+    while(offset < static_cast<std::size_t>(length)) {
+        inotify_event event{};
+        std::memcpy(&event, &buffer[offset], sizeof(event));
+        if(event.len > 0 &&
+           base_name == std::string(&buffer[offset + sizeof(event)])) {
+            ++num_matching;
+        }
+        offset += sizeof(event) + event.len;
+    }
+    return num_matching;
+}
+
+auto FileWatcher::wait_for_change() -> bool {
+    // editors save in several steps; let the burst settle before re-reading
+    constexpr const int SETTLE_MILLISECONDS = 50;
+
+    if(!valid()) {
+        return false;
+    }
+    int num_matching = 0;
+    while(num_matching == 0) {
+        num_matching = read_events(-1);
+        if(num_matching < 0) {
+            return false;
+        }
+    }
+    while(read_events(SETTLE_MILLISECONDS) > 0) {
+    }
+    return true;
+}
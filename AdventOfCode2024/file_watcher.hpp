@@ -0,0 +1,39 @@
+#ifndef FILE_WATCHER_HPP
+#define FILE_WATCHER_HPP
+
+#include <string>
+
+/**
+ * Blocks until a file changes, using inotify. The containing directory is
+ * watched rather than the file itself, so editors that save by writing a new
+ * file and renaming it over the old one are noticed too, and the watch
+ * survives the file being replaced.
+ */
+class FileWatcher {
+  public:
+    explicit FileWatcher(const std::string &file_name);
+    ~FileWatcher();
+
+    FileWatcher(const FileWatcher &) = delete;
+    FileWatcher(FileWatcher &&) = delete;
+    auto operator=(const FileWatcher &) -> FileWatcher & = delete;
+    auto operator=(FileWatcher &&) -> FileWatcher & = delete;
+
+    [[nodiscard]] auto valid() const -> bool { return watch_descriptor >= 0; }
+
+    /**
+     * Wait for the next change to the file. A burst of events (one save can
+     * produce several) is reported as a single change. Returns false if
+     * watching failed.
+     */
+    auto wait_for_change() -> bool;
+
+  private:
+    auto read_events(int timeout_milliseconds) -> int;
+
+    int inotify_fd = -1;
+    int watch_descriptor = -1;
+    std::string base_name{};
+};
+
+#endif
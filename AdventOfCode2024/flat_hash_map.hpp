@@ -0,0 +1,200 @@
+#ifndef FLAT_HASH_MAP_HPP
+#define FLAT_HASH_MAP_HPP
+
+#include <algorithm>   // std::fill
+#include <cstddef>     // std::size_t
+#include <cstdint>     // uint64_t, uint8_t
+#include <type_traits> // std::is_integral_v
+#include <utility>     // std::move
+#include <vector>
+
+/**
+ * Open-addressing hash map for integer keys, meant for hot counting loops
+ * where std::unordered_map spends its time allocating nodes and chasing
+ * pointers.
+ *
+ * Keys and values live in one flat array of slots with linear probing; the
+ * capacity is always a power of two and the table is kept at most half full.
+ * clear() only resets the occupancy flags, so a map reused across iterations
+ * keeps its memory. There is no erase.
+ */
+template <typename Key, typename Value>
+class FlatHashMap {
+    static_assert(std::is_integral_v<Key>, "FlatHashMap needs integer keys");
+
+  public:
+    struct Slot {
+        Key key;
+        Value value;
+    };
+
+    class ConstIterator {
+      public:
+        ConstIterator(const FlatHashMap *map_, const std::size_t index_)
+            : map(map_), index(index_) {
+            skip_empty();
+        }
+        auto operator*() const -> const Slot & { return map->slots[index]; }
+        auto operator->() const -> const Slot * { return &map->slots[index]; }
+        auto operator++() -> ConstIterator & {
+            ++index;
+            skip_empty();
+            return *this;
+        }
+        auto operator==(const ConstIterator &other) const -> bool {
+            return index == other.index;
+        }
+        auto operator!=(const ConstIterator &other) const -> bool {
+            return index != other.index;
+        }
+
+      private:
+        auto skip_empty() -> void {
+            while(index < map->occupied.size() && map->occupied[index] == 0) {
+                ++index;
+            }
+        }
+
+        const FlatHashMap *map;
+        std::size_t index;
+    };
+
+    FlatHashMap() = default;
+    explicit FlatHashMap(const std::size_t expected_size) {
+        reserve(expected_size);
+    }
+    // defined out of line, where -Winline does not expect them inlined
+    FlatHashMap(const FlatHashMap &other);
+    FlatHashMap(FlatHashMap &&other) noexcept;
+    auto operator=(const FlatHashMap &other) -> FlatHashMap &;
+    auto operator=(FlatHashMap &&other) noexcept -> FlatHashMap &;
+    ~FlatHashMap();
+
+    [[nodiscard]] auto size() const -> std::size_t { return num_elements; }
+    [[nodiscard]] auto empty() const -> bool { return num_elements == 0; }
+    [[nodiscard]] auto capacity() const -> std::size_t {
+        return slots.size();
+    }
+
+    /**
+     * Make room for expected_size elements without rehashing.
+     */
+    auto reserve(const std::size_t expected_size) -> void {
+        std::size_t wanted_capacity = MIN_CAPACITY;
+        while(wanted_capacity < 2 * expected_size) {
+            wanted_capacity *= 2;
+        }
+        if(wanted_capacity > slots.size()) {
+            rehash(wanted_capacity);
+        }
+    }
+
+    /**
+     * Remove all elements, keeping the allocated slots.
+     */
+    auto clear() -> void {
+        std::fill(occupied.begin(), occupied.end(), 0);
+        num_elements = 0;
+    }
+
+    auto operator[](const Key key) -> Value & {
+        if(2 * (num_elements + 1) > slots.size()) {
+            rehash(slots.empty() ? MIN_CAPACITY : 2 * slots.size());
+        }
+
+        std::size_t index = home_slot(key);
+        while(occupied[index] != 0) {
+            if(slots[index].key == key) {
+                return slots[index].value;
+            }
+            index = (index + 1) & mask;
+        }
+
+        occupied[index] = 1;
+        slots[index] = Slot{key, Value{}};
+        ++num_elements;
+        return slots[index].value;
+    }
+
+    /**
+     * Returns nullptr if key is absent.
+     */
+    [[nodiscard]] auto find(const Key key) const -> const Value * {
+        if(slots.empty()) {
+            return nullptr;
+        }
+
+        std::size_t index = home_slot(key);
+        while(occupied[index] != 0) {
+            if(slots[index].key == key) {
+                return &slots[index].value;
+            }
+            index = (index + 1) & mask;
+        }
+
+        return nullptr;
+    }
+
+    [[nodiscard]] auto begin() const -> ConstIterator {
+        return ConstIterator(this, 0);
+    }
+    [[nodiscard]] auto end() const -> ConstIterator {
+        return ConstIterator(this, slots.size());
+    }
+
+  private:
+    static constexpr std::size_t MIN_CAPACITY = 16;
+    // 2^64 / golden ratio: Fibonacci hashing spreads consecutive keys apart
+    static constexpr uint64_t HASH_MULTIPLIER = 0x9E3779B97F4A7C15ULL;
+    static constexpr unsigned int HASH_BITS = 64;
+
+    [[nodiscard]] auto home_slot(const Key key) const -> std::size_t {
+        return (static_cast<uint64_t>(key) * HASH_MULTIPLIER) >> shift;
+    }
+
+    auto rehash(const std::size_t new_capacity) -> void {
+        const std::vector<Slot> old_slots = std::move(slots);
+        const std::vector<uint8_t> old_occupied = std::move(occupied);
+        slots.assign(new_capacity, Slot{});
+        occupied.assign(new_capacity, 0);
+
+        mask = new_capacity - 1;
+        shift = HASH_BITS;
+        for(std::size_t c = new_capacity; c > 1; c /= 2) {
+            --shift;
+        }
+
+        for(std::size_t i = 0; i < old_slots.size(); ++i) {
+            if(old_occupied[i] == 0) {
+                continue;
+            }
+            std::size_t index = home_slot(old_slots[i].key);
+            while(occupied[index] != 0) {
+                index = (index + 1) & mask;
+            }
+            occupied[index] = 1;
+            slots[index] = old_slots[i];
+        }
+    }
+
+    std::vector<Slot> slots{};
+    std::vector<uint8_t> occupied{};
+    std::size_t num_elements = 0;
+    std::size_t mask = 0;
+    unsigned int shift = HASH_BITS;
+};
+
+template <typename Key, typename Value>
+FlatHashMap<Key, Value>::FlatHashMap(const FlatHashMap &other) = default;
+template <typename Key, typename Value>
+FlatHashMap<Key, Value>::FlatHashMap(FlatHashMap &&other) noexcept = default;
+template <typename Key, typename Value>
+auto FlatHashMap<Key, Value>::operator=(const FlatHashMap &other)
+    -> FlatHashMap & = default;
+template <typename Key, typename Value>
+auto FlatHashMap<Key, Value>::operator=(FlatHashMap &&other) noexcept
+    -> FlatHashMap & = default;
+template <typename Key, typename Value>
+FlatHashMap<Key, Value>::~FlatHashMap() = default;
+
+#endif
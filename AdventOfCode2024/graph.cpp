@@ -0,0 +1,50 @@
+#include <algorithm> // std::sort, std::binary_search, std::set_intersection
+#include <cstddef>
+#include <iterator> // std::back_inserter
+#include <span>
+#include <vector>
+
+#include "graph.hpp"
+
+CsrGraph::CsrGraph(const std::size_t num_nodes_,
+                   const std::vector<Edge> &edges)
+    : offsets(num_nodes_ + 1, 0), targets(edges.size()) {
+    // counting sort by source node
+    for(const Edge &edge : edges) {
+        ++offsets[edge.first + 1];
+    }
+    for(std::size_t node = 0; node < num_nodes_; ++node) {
+        offsets[node + 1] += offsets[node];
+    }
+    std::vector<std::size_t> next_slot(offsets.begin(), offsets.end() - 1);
+    for(const Edge &edge : edges) {
+        targets[next_slot[edge.first]++] = edge.second;
+    }
+
+    for(std::size_t node = 0; node < num_nodes_; ++node) {
+        std::sort(targets.begin() + static_cast<std::ptrdiff_t>(offsets[node]),
+                  targets.begin() +
+                      static_cast<std::ptrdiff_t>(offsets[node + 1]));
+    }
+}
+
+CsrGraph::CsrGraph(const CsrGraph &other) = default;
+CsrGraph::CsrGraph(CsrGraph &&other) noexcept = default;
+auto CsrGraph::operator=(const CsrGraph &other) -> CsrGraph & = default;
+auto CsrGraph::operator=(CsrGraph &&other) noexcept -> CsrGraph & = default;
+CsrGraph::~CsrGraph() = default;
+
+auto CsrGraph::has_edge(const std::size_t from, const std::size_t to) const
+    -> bool {
+    const std::span<const std::size_t> candidates = neighbors(from);
+    return std::binary_search(candidates.begin(), candidates.end(), to);
+}
+
+auto sorted_intersection(const std::span<const std::size_t> a,
+                         const std::span<const std::size_t> b)
+    -> std::vector<std::size_t> {
+    std::vector<std::size_t> common;
+    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(),
+                          std::back_inserter(common));
+    return common;
+}
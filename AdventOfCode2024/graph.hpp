@@ -0,0 +1,116 @@
+#ifndef GRAPH_HPP
+#define GRAPH_HPP
+
+#include <cstddef> // std::size_t
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <utility> // std::pair
+#include <vector>
+
+/**
+ * Maps node names (strings, sparse integers, ...) to dense ids 0, 1, 2, ...
+ * in first-seen order, so that everything after parsing can index plain
+ * vectors instead of looking names up in node-based containers.
+ */
+template <typename Name>
+class Interner {
+  public:
+    Interner() = default;
+    // defined out of line, where -Winline does not expect them inlined
+    Interner(const Interner &other);
+    Interner(Interner &&other) noexcept;
+    auto operator=(const Interner &other) -> Interner &;
+    auto operator=(Interner &&other) noexcept -> Interner &;
+    ~Interner();
+
+    /**
+     * Id of name, assigning the next free id if it has not been seen yet.
+     */
+    auto intern(const Name &name) -> std::size_t {
+        const auto [it, inserted] = ids.try_emplace(name, names.size());
+        if(inserted) {
+            names.push_back(name);
+        }
+        return it->second;
+    }
+
+    [[nodiscard]] auto find(const Name &name) const
+        -> std::optional<std::size_t> {
+        const auto it = ids.find(name);
+        if(it == ids.end()) {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+
+    [[nodiscard]] auto name(const std::size_t id) const -> const Name & {
+        return names[id];
+    }
+    [[nodiscard]] auto size() const -> std::size_t { return names.size(); }
+
+  private:
+    std::unordered_map<Name, std::size_t> ids{};
+    std::vector<Name> names{};
+};
+
+template <typename Name>
+Interner<Name>::Interner(const Interner &other) = default;
+template <typename Name>
+Interner<Name>::Interner(Interner &&other) noexcept = default;
+template <typename Name>
+auto Interner<Name>::operator=(const Interner &other) -> Interner & = default;
+template <typename Name>
+auto Interner<Name>::operator=(Interner &&other) noexcept
+    -> Interner & = default;
+template <typename Name>
+Interner<Name>::~Interner() = default;
+
+/**
+ * Immutable directed graph over dense node ids in compressed sparse row form:
+ * the out-neighbors of node v are targets[offsets[v] .. offsets[v + 1]), kept
+ * sorted so that adjacency tests are binary searches and common neighbors
+ * are a linear merge. Parallel edges are kept; add both directions for an
+ * undirected graph.
+ */
+class CsrGraph {
+  public:
+    using Edge = std::pair<std::size_t, std::size_t>;
+
+    CsrGraph(std::size_t num_nodes_, const std::vector<Edge> &edges);
+    CsrGraph(const CsrGraph &other);
+    CsrGraph(CsrGraph &&other) noexcept;
+    auto operator=(const CsrGraph &other) -> CsrGraph &;
+    auto operator=(CsrGraph &&other) noexcept -> CsrGraph &;
+    ~CsrGraph();
+
+    [[nodiscard]] auto num_nodes() const -> std::size_t {
+        return offsets.size() - 1;
+    }
+    [[nodiscard]] auto num_edges() const -> std::size_t {
+        return targets.size();
+    }
+    [[nodiscard]] auto degree(const std::size_t node) const -> std::size_t {
+        return offsets[node + 1] - offsets[node];
+    }
+    [[nodiscard]] auto neighbors(const std::size_t node) const
+        -> std::span<const std::size_t> {
+        return {targets.data() + offsets[node], degree(node)};
+    }
+
+    [[nodiscard, gnu::pure]] auto has_edge(std::size_t from,
+                                           std::size_t to) const -> bool;
+
+  private:
+    std::vector<std::size_t> offsets;
+    std::vector<std::size_t> targets;
+};
+
+/**
+ * Elements present in both sorted ranges, in sorted order.
+ */
+auto sorted_intersection(std::span<const std::size_t> a,
+                         std::span<const std::size_t> b)
+    -> std::vector<std::size_t>;
+
+#endif
@@ -0,0 +1,389 @@
+#include <algorithm> // std::min
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <future>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility> // std::move
+#include <vector>
+
+#include "input_prefetch.hpp"
+
+#ifdef HAVE_IO_URING
+#include <cerrno> // errno, EINTR
+#include <fcntl.h> // open
+#include <linux/io_uring.h>
+#include <sys/mman.h>    // mmap, munmap
+#include <sys/stat.h>    // fstat
+#include <sys/syscall.h> // __NR_io_uring_setup, __NR_io_uring_enter
+#include <unistd.h>      // close, syscall
+#endif
+
+static auto read_file_synchronously(const std::string &file_name)
+    -> std::optional<std::string> {
+    std::ifstream input_file{file_name, std::ios::binary};
+    if(!input_file) {
+        return std::nullopt;
+    }
+    std::ostringstream contents;
+    contents << input_file.rdbuf();
+    return std::move(contents).str();
+}
+
+#ifdef HAVE_IO_URING
+
+/**
+ * Minimal io_uring wrapper over the raw system calls (no liburing), with
+ * just enough to submit reads and reap their completions.
+ */
+class IoUring {
+  public:
+    explicit IoUring(const unsigned int requested_entries) {
+        io_uring_params params{};
+        const long fd =
+            syscall(__NR_io_uring_setup, requested_entries, &params);
+        if(fd < 0) {
+            return;
+        }
+        ring_fd = static_cast<int>(fd);
+        entries = params.sq_entries;
+
+        sq_ring_size =
+            params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+        cq_ring_size =
+            params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const bool single_mmap =
+            (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if(single_mmap) {
+            sq_ring_size = std::max(sq_ring_size, cq_ring_size);
+        }
+
+        sq_ring = map_region(sq_ring_size, IORING_OFF_SQ_RING);
+        if(sq_ring == nullptr) {
+            return;
+        }
+        if(single_mmap) {
+            cq_ring = sq_ring;
+        } else {
+            cq_ring = map_region(cq_ring_size, IORING_OFF_CQ_RING);
+            if(cq_ring == nullptr) {
+                return;
+            }
+        }
+        sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+        void *sqes_region = map_region(sqes_size, IORING_OFF_SQES);
+        if(sqes_region == nullptr) {
+            return;
+        }
+        sqes = static_cast<io_uring_sqe *>(sqes_region);
+
+        sq_tail = field<unsigned int>(sq_ring, params.sq_off.tail);
+        sq_mask = *field<unsigned int>(sq_ring, params.sq_off.ring_mask);
+        sq_array = field<unsigned int>(sq_ring, params.sq_off.array);
+        cq_head = field<unsigned int>(cq_ring, params.cq_off.head);
+        cq_tail = field<unsigned int>(cq_ring, params.cq_off.tail);
+        cq_mask = *field<unsigned int>(cq_ring, params.cq_off.ring_mask);
+        cqes = field<io_uring_cqe>(cq_ring, params.cq_off.cqes);
+        usable = true;
+    }
+
+    ~IoUring() {
+        if(sqes != nullptr) {
+            munmap(sqes, sqes_size);
+        }
+        if(cq_ring != nullptr && cq_ring != sq_ring) {
+            munmap(cq_ring, cq_ring_size);
+        }
+        if(sq_ring != nullptr) {
+            munmap(sq_ring, sq_ring_size);
+        }
+        if(ring_fd >= 0) {
+            close(ring_fd);
+        }
+    }
+
+    IoUring(const IoUring &) = delete;
+    IoUring(IoUring &&) = delete;
+    auto operator=(const IoUring &) -> IoUring & = delete;
+    auto operator=(IoUring &&) -> IoUring & = delete;
+
+    [[nodiscard]] auto valid() const -> bool { return usable; }
+    [[nodiscard]] auto capacity() const -> unsigned int { return entries; }
+
+    /**
+     * Queue a read; the caller keeps at most capacity() reads in flight.
+     */
+    auto queue_read(const int fd, char *buffer, const unsigned int length,
+                    const uint64_t offset, const uint64_t user_data) -> void {
+        const unsigned int tail = *sq_tail;
+        const unsigned int index = tail & sq_mask;
+        io_uring_sqe &sqe = sqes[index];
+        sqe = io_uring_sqe{};
+        sqe.opcode = IORING_OP_READ;
+        sqe.fd = fd;
+        sqe.off = offset;
+        sqe.addr = reinterpret_cast<uintptr_t>(buffer);
+        sqe.len = length;
+        sqe.user_data = user_data;
+        sq_array[index] = index;
+        std::atomic_ref<unsigned int>(*sq_tail).store(
+            tail + 1, std::memory_order_release);
+        ++num_queued;
+    }
+
+    /**
+     * Submit everything queued so far and wait for at least one completion.
+     * On failure nothing new was submitted, but reads submitted by earlier
+     * calls are still in flight.
+     */
+    auto submit_and_wait() -> bool {
+        const long submitted =
+            syscall(__NR_io_uring_enter, ring_fd, num_queued, 1U,
+                    IORING_ENTER_GETEVENTS, nullptr, 0);
+        if(submitted < 0) {
+            return false;
+        }
+        // anything the kernel did not take yet goes out with the next call
+        num_queued -= static_cast<unsigned int>(submitted);
+        return true;
+    }
+
+    /**
+     * Wait for at least one completion without submitting anything.
+     */
+    auto wait() -> bool {
+        long waited = 0;
+        do {
+            waited = syscall(__NR_io_uring_enter, ring_fd, 0U, 1U,
+                             IORING_ENTER_GETEVENTS, nullptr, 0);
+        } while(waited < 0 && errno == EINTR);
+        return waited >= 0;
+    }
+
+    /**
+     * Reads queued but not yet taken by the kernel; they never complete
+     * unless submitted.
+     */
+    [[nodiscard]] auto num_unsubmitted() const -> unsigned int {
+        return num_queued;
+    }
+
+    auto pop_completion(uint64_t &user_data, int &result) -> bool {
+        const unsigned int head = *cq_head;
+        if(head == std::atomic_ref<unsigned int>(*cq_tail).load(
+                       std::memory_order_acquire)) {
+            return false;
+        }
+        const io_uring_cqe &cqe = cqes[head & cq_mask];
+        user_data = cqe.user_data;
+        result = cqe.res;
+        std::atomic_ref<unsigned int>(*cq_head).store(
+            head + 1, std::memory_order_release);
+        return true;
+    }
+
+  private:
+    template <typename T>
+    static auto field(void *region, const unsigned int offset) -> T * {
+        return static_cast<T *>(
+            static_cast<void *>(static_cast<char *>(region) + offset));
+    }
+
+    [[nodiscard]] auto map_region(const std::size_t size,
+                                  const uint64_t offset) const -> void * {
+        void *region = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                            MAP_SHARED | MAP_POPULATE, ring_fd,
+                            static_cast<off_t>(offset));
+        return (region == MAP_FAILED) ? nullptr : region;
+    }
+
+    int ring_fd = -1;
+    unsigned int entries = 0;
+    bool usable = false;
+    unsigned int num_queued = 0;
+
+    void *sq_ring = nullptr;
+    void *cq_ring = nullptr;
+    std::size_t sq_ring_size = 0;
+    std::size_t cq_ring_size = 0;
+    std::size_t sqes_size = 0;
+    io_uring_sqe *sqes = nullptr;
+    io_uring_cqe *cqes = nullptr;
+    unsigned int *sq_tail = nullptr;
+    unsigned int *sq_array = nullptr;
+    unsigned int sq_mask = 0;
+    unsigned int *cq_head = nullptr;
+    unsigned int *cq_tail = nullptr;
+    unsigned int cq_mask = 0;
+};
+
+struct PendingRead {
+    int fd = -1;
+    std::string buffer{};
+    std::size_t bytes_read = 0;
+    bool done = false;
+};
+
+/**
+ * Drive all reads through one ring. Anything the ring cannot do for a given
+ * file (open/stat failure, empty or special file, read error) falls back to
+ * an ordinary synchronous read of that file. Returns false without touching
+ * any file if no ring could be set up.
+ */
+static auto read_files_with_io_uring(
+    const std::vector<std::string> &file_names,
+    std::vector<std::promise<std::optional<std::string>>> &promises) -> bool {
+    constexpr const unsigned int QUEUE_DEPTH = 32;
+    // keep single reads well below the 32-bit length limit
+    constexpr const std::size_t MAX_READ_SIZE = std::size_t{1} << 30U;
+
+    // declared before the ring, so the ring (and any read still in flight)
+    // is torn down before the buffers are freed
+    std::vector<PendingRead> reads(file_names.size());
+    IoUring ring(QUEUE_DEPTH);
+    if(!ring.valid()) {
+        return false;
+    }
+
+    const auto finish = [&](const std::size_t i,
+                            std::optional<std::string> contents) {
+        if(reads[i].fd >= 0) {
+            close(reads[i].fd);
+        }
+        reads[i].done = true;
+        promises[i].set_value(std::move(contents));
+    };
+
+    std::vector<std::size_t> ready_to_queue;
+    for(std::size_t i = 0; i < file_names.size(); ++i) {
+        reads[i].fd = open(file_names[i].c_str(), O_RDONLY | O_CLOEXEC);
+        struct stat file_status {};
+        if(reads[i].fd < 0 || fstat(reads[i].fd, &file_status) != 0 ||
+           file_status.st_size <= 0) {
+            finish(i, read_file_synchronously(file_names[i]));
+            continue;
+        }
+        reads[i].buffer.resize(static_cast<std::size_t>(file_status.st_size));
+        ready_to_queue.push_back(i);
+    }
+
+    std::size_t in_flight = 0;
+    while(!ready_to_queue.empty() || in_flight > 0) {
+        while(!ready_to_queue.empty() && in_flight < ring.capacity()) {
+            PendingRead &read = reads[ready_to_queue.back()];
+            const std::size_t remaining = read.buffer.size() - read.bytes_read;
+            ring.queue_read(
+                read.fd, &read.buffer[read.bytes_read],
+                static_cast<unsigned int>(std::min(remaining, MAX_READ_SIZE)),
+                read.bytes_read, ready_to_queue.back());
+            ready_to_queue.pop_back();
+            ++in_flight;
+        }
+        uint64_t user_data = 0;
+        int result = 0;
+        if(!ring.submit_and_wait()) {
+            // the kernel may still be writing into the buffers of submitted
+            // reads, so reap those before any buffer is reread or freed
+            in_flight -= ring.num_unsubmitted();
+            while(in_flight > 0 && ring.wait()) {
+                while(in_flight > 0 && ring.pop_completion(user_data, result)) {
+                    --in_flight;
+                }
+            }
+            break;
+        }
+
+        while(ring.pop_completion(user_data, result)) {
+            --in_flight;
+            const std::size_t i = user_data;
+            PendingRead &read = reads[i];
+            if(result < 0) {
+                finish(i, read_file_synchronously(file_names[i]));
+            } else if(result == 0) {
+                // the file shrank since fstat
+                read.buffer.resize(read.bytes_read);
+                finish(i, std::move(read.buffer));
+            } else {
+                read.bytes_read += static_cast<std::size_t>(result);
+                if(read.bytes_read == read.buffer.size()) {
+                    finish(i, std::move(read.buffer));
+                } else {
+                    ready_to_queue.push_back(i);
+                }
+            }
+        }
+    }
+
+    // the ring failed part way: finish whatever is left synchronously
+    for(std::size_t i = 0; i < reads.size(); ++i) {
+        if(!reads[i].done) {
+            finish(i, read_file_synchronously(file_names[i]));
+        }
+    }
+    if(in_flight > 0) {
+        // waiting failed too, so there is no telling when the kernel is done
+        // with the buffers; moving the vector keeps them where they are
+        static_cast<void>(new std::vector<PendingRead>(std::move(reads)));
+    }
+    return true;
+}
+
+#endif
+
+InputPrefetcher::InputPrefetcher(std::vector<std::string> file_names_)
+    : file_names(std::move(file_names_)), promises(file_names.size()),
+      futures() {
+    for(std::promise<std::optional<std::string>> &promise : promises) {
+        futures.push_back(promise.get_future().share());
+    }
+    if(file_names.empty()) {
+        return;
+    }
+
+#ifdef HAVE_IO_URING
+    workers.emplace_back([this]() {
+        if(!read_files_with_io_uring(file_names, promises)) {
+            read_with_threads();
+        }
+    });
+#else
+    workers.emplace_back([this]() { read_with_threads(); });
+#endif
+}
+
+InputPrefetcher::~InputPrefetcher() {
+    for(std::thread &worker : workers) {
+        worker.join();
+    }
+}
+
+auto InputPrefetcher::read_with_threads() -> void {
+    constexpr const std::size_t MAX_READER_THREADS = 8;
+
+    const auto read_next_files = [this]() {
+        for(std::size_t i = next_file_index++; i < file_names.size();
+            i = next_file_index++) {
+            promises[i].set_value(read_file_synchronously(file_names[i]));
+        }
+    };
+
+    std::vector<std::thread> readers;
+    const std::size_t num_readers =
+        std::min(file_names.size(), MAX_READER_THREADS);
+    for(std::size_t i = 1; i < num_readers; ++i) {
+        readers.emplace_back(read_next_files);
+    }
+    read_next_files();
+    for(std::thread &reader : readers) {
+        reader.join();
+    }
+}
+
+auto InputPrefetcher::get(const std::size_t index) const
+    -> const std::optional<std::string> & {
+    return futures.at(index).get();
+}
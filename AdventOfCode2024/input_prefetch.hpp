@@ -0,0 +1,49 @@
+#ifndef INPUT_PREFETCH_HPP
+#define INPUT_PREFETCH_HPP
+
+#include <atomic>
+#include <cstddef> // std::size_t
+#include <future>  // std::promise, std::shared_future
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Reads a set of input files concurrently in the background, so that when
+ * many problems are solved in a row (run-all and batch modes) disk latency
+ * overlaps with solving instead of being paid file by file.
+ *
+ * All reads are issued as soon as the prefetcher is constructed: through a
+ * single io_uring where the build and the kernel support it, otherwise on a
+ * small pool of reader threads. get() blocks only until the requested file
+ * has arrived, so the first problem can start while later files are still
+ * loading.
+ */
+class InputPrefetcher {
+  public:
+    explicit InputPrefetcher(std::vector<std::string> file_names_);
+    ~InputPrefetcher();
+
+    InputPrefetcher(const InputPrefetcher &) = delete;
+    InputPrefetcher(InputPrefetcher &&) = delete;
+    auto operator=(const InputPrefetcher &) -> InputPrefetcher & = delete;
+    auto operator=(InputPrefetcher &&) -> InputPrefetcher & = delete;
+
+    /**
+     * Contents of the index-th file, or nullopt if it could not be read.
+     */
+    [[nodiscard]] auto get(std::size_t index) const
+        -> const std::optional<std::string> &;
+
+  private:
+    auto read_with_threads() -> void;
+
+    std::vector<std::string> file_names;
+    std::vector<std::promise<std::optional<std::string>>> promises;
+    std::vector<std::shared_future<std::optional<std::string>>> futures;
+    std::atomic<std::size_t> next_file_index{0};
+    std::vector<std::thread> workers{};
+};
+
+#endif
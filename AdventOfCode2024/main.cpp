@@ -1,12 +1,31 @@
+#include <algorithm> // std::any_of, std::find, std::max, std::min
+#include <array>
+#include <chrono>
+#include <cstddef> // std::size_t
 #include <cstdint>
+#include <fstream>
 #include <iostream>
+#include <optional>
+#include <sstream>
+#include <stdexcept> // std::out_of_range
 #include <string>
+#include <thread>
+#include <utility> // std::move, std::pair
 #include <vector>
 
+#include "answer_cache.hpp"
+#include "cancellation.hpp"
 #include "day.hpp"
+#include "file_watcher.hpp"
+#include "input_prefetch.hpp"
+#include "mapped_file.hpp"
+#include "utils.hpp"
 
-auto solve(const std::size_t day, const std::string &problem_version)
-    -> int64_t {
+constexpr const char *ANSWER_CACHE_DIRECTORY = ".solver_cache";
+constexpr const std::size_t NUMBER_OF_DAYS = 24;
+
+auto solve(const std::size_t day, const std::string &problem_version,
+           const CancellationToken &token) -> int64_t {
     const std::size_t star_index =
         2 * (day - 1) + ((problem_version == "B") ? 1 : 0);
     const std::vector<int64_t (*)()> problem_to_solver{
@@ -25,31 +44,630 @@ auto solve(const std::size_t day, const std::string &problem_version)
 
     int64_t (*const specific_solver_function)() =
         problem_to_solver.at(star_index);
+    const CancellationScope scope(token);
     return specific_solver_function();
 }
 
-auto main(int argc, char *argv[]) -> int {
-    const std::vector<std::string> args(argv, argv + argc);
-    if(argc != 3) {
-        std::cerr << "Parameters day number and 'A'/'B' is required"
-                  << std::endl;
-        return 1;
-    }
-    const std::string which_day{args[1]};
-    const std::string which_problem{args[2]};
+// The special members are defined out of line: these hold several strings,
+// and -Winline flags the implicit inline ones on cold paths.
+struct Options {
+    Options();
+    Options(const Options &);
+    Options(Options &&) noexcept;
+    auto operator=(const Options &) -> Options &;
+    auto operator=(Options &&) noexcept -> Options &;
+    ~Options();
+
+    bool use_cache = true;
+    bool clear_cache = false;
+    bool run_all = false;
+    std::optional<CancellationToken::Clock::duration> timeout{};
+    std::string watch_day{};
+    std::string stream_day01_file_name{};
+    std::size_t stream_chunk_bytes = std::size_t{1} << 20U;
+    std::size_t stream_dense_limit = std::size_t{1} << 17U;
+    std::optional<std::size_t> day02_max_removals{};
+    std::string scan_day03_file_name{};
+    std::string stream_day03_file_name{};
+    std::string day04_words_file_name{};
+    std::string scan_day04_file_name{};
+    std::string day05_rule_updates_file_name{};
+    std::optional<std::size_t> day05_max_dense_rule_pages{};
+    std::size_t num_threads = 0;
+    std::string batch_file_name{};
+    std::vector<std::string> positional{};
+};
+
+Options::Options() = default;
+Options::Options(const Options &) = default;
+Options::Options(Options &&) noexcept = default;
+auto Options::operator=(const Options &) -> Options & = default;
+auto Options::operator=(Options &&) noexcept -> Options & = default;
+Options::~Options() = default;
 
+struct Problem {
+    Problem(std::size_t day_, std::string problem_version_,
+            std::string input_file_name_);
+    Problem(const Problem &);
+    Problem(Problem &&) noexcept;
+    auto operator=(const Problem &) -> Problem &;
+    auto operator=(Problem &&) noexcept -> Problem &;
+    ~Problem();
+
+    std::size_t day;
+    std::string problem_version;
+    std::string input_file_name;
+};
+
+Problem::Problem(const std::size_t day_, std::string problem_version_,
+                 std::string input_file_name_)
+    : day(day_), problem_version(std::move(problem_version_)),
+      input_file_name(std::move(input_file_name_)) {}
+Problem::Problem(const Problem &) = default;
+Problem::Problem(Problem &&) noexcept = default;
+auto Problem::operator=(const Problem &) -> Problem & = default;
+auto Problem::operator=(Problem &&) noexcept -> Problem & = default;
+Problem::~Problem() = default;
+
+auto parse_problem(const std::string &which_day,
+                   const std::string &which_problem)
+    -> std::optional<Problem> {
     if(which_problem != "A" && which_problem != "B") {
         std::cerr << "Argument must be either 'A' or 'B'" << std::endl;
-        return 1;
+        return std::nullopt;
     }
 
     const int day_number = std::stoi(which_day);
     if(day_number <= 0) {
         std::cerr << "Day number must be at least 1" << std::endl;
+        return std::nullopt;
+    }
+
+    const auto day = std::size_t(day_number);
+    return Problem{day, which_problem, input_file_name_for_day(day)};
+}
+
+/**
+ * Whether the solver prints its answer itself and returns a placeholder. Such
+ * problems are never cached, since a cache hit would print nothing.
+ */
+[[gnu::pure]] auto prints_its_answer(const Problem &problem) -> bool {
+    const std::array<std::pair<std::size_t, const char *>, 3> printing_problems{
+        {{17, "A"}, {18, "B"}, {23, "B"}}};
+    return std::any_of(
+        printing_problems.begin(), printing_problems.end(),
+        [&problem](const std::pair<std::size_t, const char *> &printing) {
+            return printing.first == problem.day &&
+                   problem.problem_version == printing.second;
+        });
+}
+
+/**
+ * Solve a single problem from its already-loaded input, consulting the answer
+ * cache first. On a hit the input is only hashed, never parsed. On a miss the
+ * bytes are handed to the solver, so it never touches the disk. Problems whose
+ * solver prints the answer bypass the cache. Throws SolveCancelled if the
+ * solver runs past the token's deadline.
+ */
+auto solve_with_cache(const Problem &problem, const std::string &contents,
+                      const AnswerCache &cache, const bool use_cache,
+                      const CancellationToken &token) -> int64_t {
+    const bool cacheable = use_cache && !prints_its_answer(problem);
+    const AnswerCacheKey key{problem.day, problem.problem_version,
+                             hash_bytes(contents)};
+
+    if(cacheable) {
+        const std::optional<int64_t> cached_answer = cache.lookup(key);
+        if(cached_answer.has_value()) {
+            return *cached_answer;
+        }
+    }
+
+    clear_input_overrides();
+    set_input_override(input_file_name_for_day(problem.day), contents);
+    const int64_t result = solve(problem.day, problem.problem_version, token);
+
+    if(cacheable) {
+        cache.store(key, result);
+    }
+    return result;
+}
+
+/**
+ * Solve the problems in order. Every distinct input file is requested from
+ * the prefetcher up front, so later files load while earlier problems are
+ * being solved. With print_problem each answer is printed as
+ * "<day> <A|B> <input file> <answer>", otherwise just the answer. A solver
+ * that runs past the timeout is abandoned and reported, and the run moves on
+ * to the next problem.
+ */
+auto run_problems(const std::vector<Problem> &problems,
+                  const AnswerCache &cache, const Options &options,
+                  const bool print_problem) -> int {
+    std::vector<std::string> file_names;
+    std::vector<std::size_t> problem_to_file_index;
+    for(const Problem &problem : problems) {
+        const auto it = std::find(file_names.begin(), file_names.end(),
+                                  problem.input_file_name);
+        problem_to_file_index.push_back(
+            static_cast<std::size_t>(it - file_names.begin()));
+        if(it == file_names.end()) {
+            file_names.push_back(problem.input_file_name);
+        }
+    }
+    const InputPrefetcher prefetcher{file_names};
+
+    int exit_code = 0;
+    for(std::size_t i = 0; i < problems.size(); ++i) {
+        const Problem &problem = problems[i];
+        const std::optional<std::string> &contents =
+            prefetcher.get(problem_to_file_index[i]);
+        if(!contents.has_value()) {
+            std::cerr << "Cannot read input file " << problem.input_file_name
+                      << std::endl;
+            exit_code = 1;
+            continue;
+        }
+
+        const CancellationToken token =
+            options.timeout.has_value() ? CancellationToken(*options.timeout)
+                                        : CancellationToken();
+        int64_t result = 0;
+        try {
+            result = solve_with_cache(problem, *contents, cache,
+                                      options.use_cache, token);
+        } catch(const SolveCancelled &) {
+            std::cerr << "Day " << problem.day << ' ' << problem.problem_version
+                      << " (" << problem.input_file_name << ") timed out after "
+                      << std::chrono::duration<double>(*options.timeout).count()
+                      << " s" << std::endl;
+            exit_code = 1;
+            continue;
+        }
+        if(print_problem) {
+            std::cout << problem.day << ' ' << problem.problem_version << ' '
+                      << problem.input_file_name << ' ';
+        }
+        std::cout << result << std::endl;
+    }
+
+    return exit_code;
+}
+
+/**
+ * Each non-empty line of the batch file is "<day> <A|B> [input file]"; the
+ * input file defaults to data/dayNN.txt. Answers are printed one per line in
+ * the same order.
+ */
+auto run_batch(const std::string &batch_file_name, const AnswerCache &cache,
+               const Options &options) -> int {
+    std::ifstream batch_file{batch_file_name};
+    if(!batch_file) {
+        std::cerr << "Cannot read batch file " << batch_file_name << std::endl;
         return 1;
     }
-    const int64_t result = solve(std::size_t(day_number), which_problem);
 
-    std::cout << result << std::endl;
+    std::vector<Problem> problems;
+    std::string line;
+    while(std::getline(batch_file, line)) {
+        std::stringstream ss(line);
+        std::string which_day;
+        std::string which_problem;
+        std::string input_file_name;
+        if(!(ss >> which_day)) {
+            continue;
+        }
+        ss >> which_problem >> input_file_name;
+
+        std::optional<Problem> problem =
+            parse_problem(which_day, which_problem);
+        if(!problem.has_value()) {
+            std::cerr << "Invalid batch line: " << line << std::endl;
+            return 1;
+        }
+        if(!input_file_name.empty()) {
+            problem->input_file_name = input_file_name;
+        }
+        problems.push_back(*problem);
+    }
+
+    return run_problems(problems, cache, options, true);
+}
+
+/**
+ * Both parts of every day, on the default input files.
+ */
+auto all_problems() -> std::vector<Problem> {
+    std::vector<Problem> problems;
+    for(std::size_t day = 1; day <= NUMBER_OF_DAYS; ++day) {
+        for(const std::string problem_version : {"A", "B"}) {
+            problems.push_back(
+                Problem{day, problem_version, input_file_name_for_day(day)});
+        }
+    }
+    return problems;
+}
+
+/**
+ * Solve both parts of one day, then again every time its input file changes,
+ * until interrupted. State the solvers keep between calls (tables that do
+ * not depend on the input, parsed sections an edit did not touch) stays
+ * warm, so re-solves after small edits are faster than a cold run.
+ */
+auto run_watch(const std::string &which_day, const AnswerCache &cache,
+               const Options &options) -> int {
+    std::vector<Problem> problems;
+    for(const std::string problem_version : {"A", "B"}) {
+        const std::optional<Problem> problem =
+            parse_problem(which_day, problem_version);
+        if(!problem.has_value()) {
+            return 1;
+        }
+        problems.push_back(*problem);
+    }
+
+    // watch before the first solve, so edits made during it are not missed
+    FileWatcher watcher(problems[0].input_file_name);
+    if(!watcher.valid()) {
+        std::cerr << "Cannot watch input file " << problems[0].input_file_name
+                  << std::endl;
+        return 1;
+    }
+
+    while(true) {
+        const auto start = std::chrono::steady_clock::now();
+        run_problems(problems, cache, options, true);
+        const std::chrono::duration<double, std::milli> elapsed =
+            std::chrono::steady_clock::now() - start;
+        std::cout << "Solved in " << elapsed.count() << " ms; watching "
+                  << problems[0].input_file_name << " for changes"
+                  << std::endl;
+
+        if(!watcher.wait_for_change()) {
+            std::cerr << "Stopped watching " << problems[0].input_file_name
+                      << std::endl;
+            return 1;
+        }
+    }
+}
+
+/**
+ * Threads for the parallel scans: options.num_threads, or one per core if
+ * that is 0. Capped at a few per core, since every thread is a real
+ * std::thread and more of them only add overhead.
+ */
+auto resolve_num_threads(const Options &options) -> std::size_t {
+    constexpr const std::size_t MAX_THREADS_PER_CORE = 4;
+
+    const std::size_t num_cores =
+        std::max(1U, std::thread::hardware_concurrency());
+    if(options.num_threads == 0) {
+        return num_cores;
+    }
+    return std::min(options.num_threads, MAX_THREADS_PER_CORE * num_cores);
+}
+
+/**
+ * Day 3 parts A and B over a memory dump of any size, mapped rather than
+ * read and scanned on options.num_threads threads (0: one per core).
+ */
+auto run_scan_day03(const Options &options) -> int {
+    const MappedFile memory{options.scan_day03_file_name};
+    if(!memory.valid()) {
+        std::cerr << "Cannot read input file " << options.scan_day03_file_name
+                  << std::endl;
+        return 1;
+    }
+
+    const auto [sum_of_all, sum_of_enabled] =
+        scan_day03_memory(memory.contents(), resolve_num_threads(options));
+    std::cout << sum_of_all << '\n' << sum_of_enabled << std::endl;
     return 0;
 }
+
+/**
+ * Day 4 parts A and B over a grid of any size, searched in row bands on
+ * options.num_threads threads (0: one per core).
+ */
+auto run_scan_day04(const Options &options) -> int {
+    const MappedFile grid{options.scan_day04_file_name};
+    if(!grid.valid()) {
+        std::cerr << "Cannot read input file " << options.scan_day04_file_name
+                  << std::endl;
+        return 1;
+    }
+
+    const auto [xmas_count, double_mas_count] =
+        scan_day04_grid(grid.contents(), resolve_num_threads(options));
+    std::cout << xmas_count << '\n' << double_mas_count << std::endl;
+    return 0;
+}
+
+/**
+ * Day 3 parts A and B over a feed of any length ("-" reads standard input),
+ * read options.stream_chunk_bytes at a time.
+ */
+auto run_stream_day03(const Options &options) -> int {
+    std::ifstream input_file;
+    if(options.stream_day03_file_name != "-") {
+        input_file.open(options.stream_day03_file_name, std::ios::binary);
+        if(!input_file) {
+            std::cerr << "Cannot read input file "
+                      << options.stream_day03_file_name << std::endl;
+            return 1;
+        }
+    }
+    std::istream &feed =
+        (options.stream_day03_file_name == "-") ? std::cin : input_file;
+
+    const auto [sum_of_all, sum_of_enabled] =
+        stream_day03_memory(feed, options.stream_chunk_bytes);
+    std::cout << sum_of_all << '\n' << sum_of_enabled << std::endl;
+    return 0;
+}
+
+/**
+ * How often each word of the file (one per line) appears in the day 4 grid,
+ * printed as "<word> <count>" lines.
+ */
+auto run_day04_words(const Options &options) -> int {
+    std::ifstream words_file{options.day04_words_file_name};
+    if(!words_file) {
+        std::cerr << "Cannot read input file " << options.day04_words_file_name
+                  << std::endl;
+        return 1;
+    }
+    std::vector<std::string> words;
+    std::string line;
+    while(std::getline(words_file, line)) {
+        if(!line.empty()) {
+            words.push_back(line);
+        }
+    }
+
+    const std::vector<int64_t> counts = count_day04_words(words);
+    for(std::size_t i = 0; i < words.size(); ++i) {
+        std::cout << words[i] << ' ' << counts[i] << '\n';
+    }
+    std::cout << std::flush;
+    return 0;
+}
+
+/**
+ * Day 5 parts A and B under the rule changes in the file, one per line as
+ * "+a|b" (add) or "-a|b" (remove), printing "<updates applied> <A> <B>"
+ * before the first change and after each one.
+ */
+auto run_day05_rule_updates(const Options &options) -> int {
+    std::ifstream updates_file{options.day05_rule_updates_file_name};
+    if(!updates_file) {
+        std::cerr << "Cannot read input file "
+                  << options.day05_rule_updates_file_name << std::endl;
+        return 1;
+    }
+    std::vector<Day05RuleUpdate> updates;
+    std::string line;
+    while(std::getline(updates_file, line)) {
+        if(line.empty()) {
+            continue;
+        }
+        const std::vector<std::string> pages = split(line.substr(1), '|');
+        if((line[0] != '+' && line[0] != '-') || pages.size() != 2) {
+            std::cerr << "Malformed rule update: " << line << std::endl;
+            return 1;
+        }
+        updates.push_back(Day05RuleUpdate{line[0] == '+', std::stoi(pages[0]),
+                                          std::stoi(pages[1])});
+    }
+
+    const auto print_sums = [](const std::size_t num_applied,
+                               const int64_t valid_sum,
+                               const int64_t corrected_sum) {
+        std::cout << num_applied << ' ' << valid_sum << ' ' << corrected_sum
+                  << '\n';
+    };
+    replay_day05_rule_updates(updates, print_sums);
+    std::cout << std::flush;
+    return 0;
+}
+
+/**
+ * Day 1 part B over a feed of any length ("-" reads standard input), printing
+ * "<pairs so far> <similarity so far>" after every chunk.
+ */
+auto run_stream_day01(const Options &options) -> int {
+    std::ifstream input_file;
+    if(options.stream_day01_file_name != "-") {
+        input_file.open(options.stream_day01_file_name, std::ios::binary);
+        if(!input_file) {
+            std::cerr << "Cannot read input file "
+                      << options.stream_day01_file_name << std::endl;
+            return 1;
+        }
+    }
+    std::istream &feed =
+        (options.stream_day01_file_name == "-") ? std::cin : input_file;
+
+    const auto print_progress = [](const std::size_t num_pairs,
+                                   const int64_t score) {
+        std::cout << num_pairs << ' ' << score << std::endl;
+    };
+    try {
+        stream_day01_similarity(feed, options.stream_chunk_bytes,
+                                options.stream_dense_limit, print_progress);
+    } catch(const std::out_of_range &error) {
+        std::cerr << error.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+auto parse_options(const std::vector<std::string> &args)
+    -> std::optional<Options> {
+    Options options;
+    for(std::size_t i = 1; i < args.size(); ++i) {
+        if(args[i] == "--no-cache") {
+            options.use_cache = false;
+        } else if(args[i] == "--clear-cache") {
+            options.clear_cache = true;
+        } else if(args[i] == "--all") {
+            options.run_all = true;
+        } else if(args[i] == "--batch") {
+            if(i + 1 == args.size()) {
+                std::cerr << "--batch requires a file name" << std::endl;
+                return std::nullopt;
+            }
+            options.batch_file_name = args[++i];
+        } else if(args[i] == "--watch") {
+            if(i + 1 == args.size()) {
+                std::cerr << "--watch requires a day number" << std::endl;
+                return std::nullopt;
+            }
+            options.watch_day = args[++i];
+        } else if(args[i] == "--stream-day01" || args[i] == "--chunk-bytes" ||
+                  args[i] == "--dense-limit") {
+            if(i + 1 == args.size()) {
+                std::cerr << args[i] << " requires an argument" << std::endl;
+                return std::nullopt;
+            }
+            if(args[i] == "--stream-day01") {
+                options.stream_day01_file_name = args[++i];
+            } else if(args[i] == "--chunk-bytes") {
+                options.stream_chunk_bytes = std::stoull(args[++i]);
+            } else {
+                options.stream_dense_limit = std::stoull(args[++i]);
+            }
+        } else if(args[i] == "--scan-day03" || args[i] == "--stream-day03" ||
+                  args[i] == "--scan-day04" || args[i] == "--threads") {
+            if(i + 1 == args.size()) {
+                std::cerr << args[i] << " requires an argument" << std::endl;
+                return std::nullopt;
+            }
+            if(args[i] == "--scan-day03") {
+                options.scan_day03_file_name = args[++i];
+            } else if(args[i] == "--stream-day03") {
+                options.stream_day03_file_name = args[++i];
+            } else if(args[i] == "--scan-day04") {
+                options.scan_day04_file_name = args[++i];
+            } else {
+                options.num_threads = std::stoull(args[++i]);
+            }
+        } else if(args[i] == "--day04-words") {
+            if(i + 1 == args.size()) {
+                std::cerr << "--day04-words requires a file name" << std::endl;
+                return std::nullopt;
+            }
+            options.day04_words_file_name = args[++i];
+        } else if(args[i] == "--day05-rule-updates") {
+            if(i + 1 == args.size()) {
+                std::cerr << "--day05-rule-updates requires a file name"
+                          << std::endl;
+                return std::nullopt;
+            }
+            options.day05_rule_updates_file_name = args[++i];
+        } else if(args[i] == "--day05-dense-pages") {
+            if(i + 1 == args.size()) {
+                std::cerr << "--day05-dense-pages requires a number of pages"
+                          << std::endl;
+                return std::nullopt;
+            }
+            options.day05_max_dense_rule_pages = std::stoull(args[++i]);
+        } else if(args[i] == "--day02-max-removals") {
+            if(i + 1 == args.size()) {
+                std::cerr << "--day02-max-removals requires a number of levels"
+                          << std::endl;
+                return std::nullopt;
+            }
+            options.day02_max_removals = std::stoull(args[++i]);
+        } else if(args[i] == "--timeout") {
+            const double seconds =
+                (i + 1 < args.size()) ? std::stod(args[++i]) : 0.0;
+            if(seconds <= 0.0) {
+                std::cerr << "--timeout requires a positive number of seconds"
+                          << std::endl;
+                return std::nullopt;
+            }
+            options.timeout = std::chrono::duration_cast<
+                CancellationToken::Clock::duration>(
+                std::chrono::duration<double>(seconds));
+        } else {
+            options.positional.push_back(args[i]);
+        }
+    }
+
+    return options;
+}
+
+auto main(int argc, char *argv[]) -> int {
+    const std::vector<std::string> args(argv, argv + argc);
+    const std::optional<Options> options = parse_options(args);
+    if(!options.has_value()) {
+        return 1;
+    }
+
+    if(options->day05_max_dense_rule_pages.has_value()) {
+        set_day05_max_dense_rule_pages(*options->day05_max_dense_rule_pages);
+    }
+
+    const AnswerCache cache{ANSWER_CACHE_DIRECTORY};
+    if(options->clear_cache) {
+        cache.clear();
+        if(options->positional.empty() && options->batch_file_name.empty() &&
+           !options->run_all && options->watch_day.empty() &&
+           options->stream_day01_file_name.empty() &&
+           !options->day02_max_removals.has_value() &&
+           options->scan_day03_file_name.empty() &&
+           options->stream_day03_file_name.empty() &&
+           options->day04_words_file_name.empty() &&
+           options->scan_day04_file_name.empty() &&
+           options->day05_rule_updates_file_name.empty()) {
+            return 0;
+        }
+    }
+
+    if(!options->batch_file_name.empty()) {
+        return run_batch(options->batch_file_name, cache, *options);
+    }
+    if(!options->stream_day01_file_name.empty()) {
+        return run_stream_day01(*options);
+    }
+    if(!options->scan_day03_file_name.empty()) {
+        return run_scan_day03(*options);
+    }
+    if(!options->stream_day03_file_name.empty()) {
+        return run_stream_day03(*options);
+    }
+    if(!options->scan_day04_file_name.empty()) {
+        return run_scan_day04(*options);
+    }
+    if(!options->day04_words_file_name.empty()) {
+        return run_day04_words(*options);
+    }
+    if(!options->day05_rule_updates_file_name.empty()) {
+        return run_day05_rule_updates(*options);
+    }
+    if(options->day02_max_removals.has_value()) {
+        std::cout << count_day02_safe_reports(*options->day02_max_removals)
+                  << std::endl;
+        return 0;
+    }
+    if(!options->watch_day.empty()) {
+        return run_watch(options->watch_day, cache, *options);
+    }
+    if(options->run_all) {
+        return run_problems(all_problems(), cache, *options, true);
+    }
+
+    if(options->positional.size() != 2) {
+        std::cerr << "Parameters day number and 'A'/'B' is required"
+                  << std::endl;
+        return 1;
+    }
+    const std::optional<Problem> problem =
+        parse_problem(options->positional[0], options->positional[1]);
+    if(!problem.has_value()) {
+        return 1;
+    }
+
+    return run_problems({*problem}, cache, *options, false);
+}
@@ -0,0 +1,38 @@
+#include <cstddef>
+#include <string>
+
+#include <fcntl.h>    // open
+#include <sys/mman.h> // mmap, munmap, madvise
+#include <sys/stat.h> // fstat
+#include <unistd.h>   // close
+
+#include "mapped_file.hpp"
+
+MappedFile::MappedFile(const std::string &file_name) {
+    const int fd = open(file_name.c_str(), O_RDONLY | O_CLOEXEC);
+    if(fd < 0) {
+        return;
+    }
+    struct stat file_status {};
+    if(fstat(fd, &file_status) == 0) {
+        size = static_cast<std::size_t>(file_status.st_size);
+        if(size == 0) {
+            is_valid = true;
+        } else {
+            void *region = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if(region != MAP_FAILED) {
+                madvise(region, size, MADV_SEQUENTIAL);
+                data = static_cast<const char *>(region);
+                is_valid = true;
+            }
+        }
+    }
+    close(fd);
+}
+
+MappedFile::~MappedFile() {
+    if(data != nullptr) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+        munmap(const_cast<char *>(data), size);
+    }
+}
@@ -0,0 +1,34 @@
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <cstddef> // std::size_t
+#include <string>
+#include <string_view>
+
+/**
+ * A whole file mapped read-only into memory, for inputs too large to copy
+ * into a std::string. The pages are read in by the kernel as they are first
+ * touched.
+ */
+class MappedFile {
+  public:
+    explicit MappedFile(const std::string &file_name);
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile(MappedFile &&) = delete;
+    auto operator=(const MappedFile &) -> MappedFile & = delete;
+    auto operator=(MappedFile &&) -> MappedFile & = delete;
+
+    [[nodiscard]] auto valid() const -> bool { return is_valid; }
+    [[nodiscard]] auto contents() const -> std::string_view {
+        return {data, size};
+    }
+
+  private:
+    const char *data = nullptr;
+    std::size_t size = 0;
+    bool is_valid = false;
+};
+
+#endif
@@ -0,0 +1,213 @@
+#ifndef MEMO_CACHE_HPP
+#define MEMO_CACHE_HPP
+
+#include <algorithm> // std::fill
+#include <array>
+#include <cstddef> // std::size_t
+#include <cstdint> // int64_t, uint64_t, uint8_t
+#include <optional>
+#include <utility> // std::move
+#include <vector>
+
+/**
+ * Memoization table for recursive solvers whose subproblems are identified
+ * by a few integers (a value and a depth, a position, an encoded string).
+ *
+ * Keys are fixed-size integer tuples stored inline in one open-addressing
+ * table with linear probing, like FlatHashMap. Unbounded caches grow as
+ * needed. A cache constructed with max_entries never holds more than that:
+ * once full, each insert evicts an entry chosen by the CLOCK policy (entries
+ * hit since the hand last passed them get a second chance), which keeps the
+ * hot subproblems resident.
+ *
+ * A cache whose values depend only on the key can be a function-local static
+ * and be shared by every input solved in the same process.
+ */
+template <std::size_t KeySize, typename Value>
+class MemoCache {
+  public:
+    using Key = std::array<int64_t, KeySize>;
+
+    struct Stats {
+        std::size_t hits = 0;
+        std::size_t misses = 0;
+        std::size_t evictions = 0;
+    };
+
+    MemoCache() = default;
+    explicit MemoCache(const std::size_t max_entries_)
+        : max_entries(max_entries_) {
+        std::size_t capacity = MIN_CAPACITY;
+        while(capacity < 2 * max_entries_) {
+            capacity *= 2;
+        }
+        rehash(capacity);
+    }
+
+    [[nodiscard]] auto size() const -> std::size_t { return num_elements; }
+    [[nodiscard]] auto stats() const -> const Stats & { return counters; }
+
+    /**
+     * Make room for expected_size entries without rehashing. Has no effect
+     * on a bounded cache, which allocates everything up front.
+     */
+    auto reserve(const std::size_t expected_size) -> void {
+        std::size_t wanted_capacity = MIN_CAPACITY;
+        while(wanted_capacity < 2 * expected_size) {
+            wanted_capacity *= 2;
+        }
+        if(max_entries == 0 && wanted_capacity > slots.size()) {
+            rehash(wanted_capacity);
+        }
+    }
+
+    /**
+     * Remove all entries, keeping the allocated slots and the statistics.
+     */
+    auto clear() -> void {
+        std::fill(states.begin(), states.end(), EMPTY);
+        num_elements = 0;
+    }
+
+    [[nodiscard]] auto find(const Key &key) -> std::optional<Value> {
+        if(!slots.empty()) {
+            for(std::size_t index = home_slot(key); states[index] != EMPTY;
+                index = (index + 1) & mask) {
+                if(slots[index].key == key) {
+                    ++counters.hits;
+                    states[index] = REFERENCED;
+                    return slots[index].value;
+                }
+            }
+        }
+        ++counters.misses;
+        return std::nullopt;
+    }
+
+    /**
+     * Store the value for a key that is not in the cache yet.
+     */
+    auto insert(const Key &key, const Value &value) -> void {
+        if(max_entries != 0 && num_elements == max_entries) {
+            evict_one();
+        } else if(2 * (num_elements + 1) > slots.size()) {
+            rehash(slots.empty() ? MIN_CAPACITY : 2 * slots.size());
+        }
+
+        std::size_t index = home_slot(key);
+        while(states[index] != EMPTY) {
+            index = (index + 1) & mask;
+        }
+        slots[index] = Slot{key, value};
+        states[index] = OCCUPIED;
+        ++num_elements;
+    }
+
+    /**
+     * The cached value for key, or compute() stored under key. compute may
+     * itself recurse into this cache.
+     */
+    template <typename Compute>
+    auto get_or_compute(const Key &key, Compute &&compute) -> Value {
+        std::optional<Value> cached = find(key);
+        if(cached.has_value()) {
+            return *cached;
+        }
+        Value value = compute();
+        insert(key, value);
+        return value;
+    }
+
+  private:
+    struct Slot {
+        Key key;
+        Value value;
+    };
+
+    static constexpr std::size_t MIN_CAPACITY = 16;
+    static constexpr uint64_t HASH_MULTIPLIER = 0x9E3779B97F4A7C15ULL;
+    static constexpr unsigned int HASH_BITS = 64;
+    static constexpr uint8_t EMPTY = 0;
+    static constexpr uint8_t OCCUPIED = 1;
+    static constexpr uint8_t REFERENCED = 2;
+
+    [[nodiscard]] auto home_slot(const Key &key) const -> std::size_t {
+        uint64_t hash = 0;
+        for(const int64_t part : key) {
+            hash = (hash ^ static_cast<uint64_t>(part)) * HASH_MULTIPLIER;
+        }
+        return hash >> shift;
+    }
+
+    auto evict_one() -> void {
+        while(true) {
+            clock_hand = (clock_hand + 1) & mask;
+            if(states[clock_hand] == REFERENCED) {
+                states[clock_hand] = OCCUPIED;
+            } else if(states[clock_hand] == OCCUPIED) {
+                erase_at(clock_hand);
+                ++counters.evictions;
+                return;
+            }
+        }
+    }
+
+    /**
+     * Backward-shift deletion: pull later entries of the probe run into the
+     * hole so that lookups never need tombstones.
+     */
+    auto erase_at(std::size_t hole) -> void {
+        for(std::size_t next = (hole + 1) & mask; states[next] != EMPTY;
+            next = (next + 1) & mask) {
+            const std::size_t home = home_slot(slots[next].key);
+            // the entry may stay put if its home lies cyclically in
+            // (hole, next]
+            const bool stays = (hole <= next) ? (hole < home && home <= next)
+                                              : (hole < home || home <= next);
+            if(stays) {
+                continue;
+            }
+            slots[hole] = std::move(slots[next]);
+            states[hole] = states[next];
+            hole = next;
+        }
+        states[hole] = EMPTY;
+        --num_elements;
+    }
+
+    auto rehash(const std::size_t new_capacity) -> void {
+        std::vector<Slot> old_slots = std::move(slots);
+        const std::vector<uint8_t> old_states = std::move(states);
+        slots.assign(new_capacity, Slot{});
+        states.assign(new_capacity, EMPTY);
+
+        mask = new_capacity - 1;
+        shift = HASH_BITS;
+        for(std::size_t c = new_capacity; c > 1; c /= 2) {
+            --shift;
+        }
+
+        for(std::size_t i = 0; i < old_slots.size(); ++i) {
+            if(old_states[i] == EMPTY) {
+                continue;
+            }
+            std::size_t index = home_slot(old_slots[i].key);
+            while(states[index] != EMPTY) {
+                index = (index + 1) & mask;
+            }
+            slots[index] = std::move(old_slots[i]);
+            states[index] = old_states[i];
+        }
+    }
+
+    std::vector<Slot> slots{};
+    std::vector<uint8_t> states{};
+    std::size_t num_elements = 0;
+    std::size_t max_entries = 0;
+    std::size_t mask = 0;
+    unsigned int shift = HASH_BITS;
+    std::size_t clock_hand = 0;
+    Stats counters{};
+};
+
+#endif
@@ -1,5 +1,11 @@
 #include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iomanip> // std::setw, std::setfill
+#include <sstream>
 #include <string>
+#include <unordered_map>
+#include <utility> // std::move
 #include <vector>
 
 #include "utils.hpp"
@@ -17,3 +23,51 @@ auto split(const std::string &text, const char delimiter)
 
     return tokens;
 }
+
+static auto input_overrides()
+    -> std::unordered_map<std::string, std::string> & {
+    static std::unordered_map<std::string, std::string> overrides;
+    return overrides;
+}
+
+auto input_file_name_for_day(const std::size_t day) -> std::string {
+    std::stringstream ss;
+    ss << "data/day" << std::setw(2) << std::setfill('0') << day << ".txt";
+    return ss.str();
+}
+
+auto set_input_override(const std::string &file_name,
+                        const std::string &contents) -> void {
+    input_overrides()[file_name] = contents;
+}
+
+auto clear_input_overrides() -> void { input_overrides().clear(); }
+
+auto read_input(const std::string &file_name) -> std::string {
+    const auto override_it = input_overrides().find(file_name);
+    if(override_it != input_overrides().end()) {
+        return override_it->second;
+    }
+
+    std::ifstream input_file{file_name, std::ios::binary};
+    std::ostringstream contents;
+    contents << input_file.rdbuf();
+    return std::move(contents).str();
+}
+
+auto open_input(const std::string &file_name) -> std::istringstream {
+    return std::istringstream(read_input(file_name));
+}
+
+auto hash_bytes(const std::string &bytes) -> uint64_t {
+    constexpr const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+    constexpr const uint64_t FNV_PRIME = 1099511628211ULL;
+
+    uint64_t hash = FNV_OFFSET_BASIS;
+    for(const char c : bytes) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= FNV_PRIME;
+    }
+
+    return hash;
+}
@@ -1,9 +1,28 @@
 #ifndef UTILS_HPP
 #define UTILS_HPP
 
+#include <cstddef> // std::size_t
+#include <cstdint> // uint64_t
+#include <sstream> // std::istringstream
 #include <string>
 #include <vector>
 
 auto split(const std::string &text, char delimiter) -> std::vector<std::string>;
 
+/**
+ * Puzzle inputs. Every solver reads its input through open_input() with its
+ * default file name ("data/dayNN.txt"). The driver may register the contents
+ * to use instead (batch mode, already-loaded inputs), in which case the
+ * solver never touches the disk.
+ */
+auto input_file_name_for_day(std::size_t day) -> std::string;
+auto set_input_override(const std::string &file_name,
+                        const std::string &contents) -> void;
+auto clear_input_overrides() -> void;
+auto read_input(const std::string &file_name) -> std::string;
+auto open_input(const std::string &file_name) -> std::istringstream;
+
+// 64-bit FNV-1a; stable across runs and platforms, so usable as a cache key
+[[gnu::pure]] auto hash_bytes(const std::string &bytes) -> uint64_t;
+
 #endif
@@ -0,0 +1,75 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/repo/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCXXSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFileCXX.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckLibraryExists.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/FindThreads.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "CMakeFiles/solver.out.dir/DependInfo.cmake"
+  "CMakeFiles/utils.dir/DependInfo.cmake"
+  "CMakeFiles/day01.dir/DependInfo.cmake"
+  "CMakeFiles/day02.dir/DependInfo.cmake"
+  "CMakeFiles/day03.dir/DependInfo.cmake"
+  "CMakeFiles/day04.dir/DependInfo.cmake"
+  "CMakeFiles/day05.dir/DependInfo.cmake"
+  "CMakeFiles/day06.dir/DependInfo.cmake"
+  "CMakeFiles/day07.dir/DependInfo.cmake"
+  "CMakeFiles/day08.dir/DependInfo.cmake"
+  "CMakeFiles/day09.dir/DependInfo.cmake"
+  "CMakeFiles/day10.dir/DependInfo.cmake"
+  "CMakeFiles/day11.dir/DependInfo.cmake"
+  "CMakeFiles/day12.dir/DependInfo.cmake"
+  "CMakeFiles/day13.dir/DependInfo.cmake"
+  "CMakeFiles/day14.dir/DependInfo.cmake"
+  "CMakeFiles/day15.dir/DependInfo.cmake"
+  "CMakeFiles/day16.dir/DependInfo.cmake"
+  "CMakeFiles/day17.dir/DependInfo.cmake"
+  "CMakeFiles/day18.dir/DependInfo.cmake"
+  "CMakeFiles/day19.dir/DependInfo.cmake"
+  "CMakeFiles/day20.dir/DependInfo.cmake"
+  "CMakeFiles/day21.dir/DependInfo.cmake"
+  "CMakeFiles/day22.dir/DependInfo.cmake"
+  "CMakeFiles/day23.dir/DependInfo.cmake"
+  "CMakeFiles/day24.dir/DependInfo.cmake"
+  )
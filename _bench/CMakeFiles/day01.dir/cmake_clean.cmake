@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/day01.dir/AdventOfCode2024/day01.cpp.o"
+  "CMakeFiles/day01.dir/AdventOfCode2024/day01.cpp.o.d"
+  "libday01.pdb"
+  "libday01.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/day01.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
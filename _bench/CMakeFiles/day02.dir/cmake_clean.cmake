@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/day02.dir/AdventOfCode2024/day02.cpp.o"
+  "CMakeFiles/day02.dir/AdventOfCode2024/day02.cpp.o.d"
+  "libday02.pdb"
+  "libday02.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/day02.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
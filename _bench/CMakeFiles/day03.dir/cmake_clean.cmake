@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/day03.dir/AdventOfCode2024/day03.cpp.o"
+  "CMakeFiles/day03.dir/AdventOfCode2024/day03.cpp.o.d"
+  "libday03.pdb"
+  "libday03.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/day03.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/day04.dir/AdventOfCode2024/day04.cpp.o"
+  "CMakeFiles/day04.dir/AdventOfCode2024/day04.cpp.o.d"
+  "libday04.pdb"
+  "libday04.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/day04.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/day05.dir/AdventOfCode2024/day05.cpp.o"
+  "CMakeFiles/day05.dir/AdventOfCode2024/day05.cpp.o.d"
+  "libday05.pdb"
+  "libday05.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/day05.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
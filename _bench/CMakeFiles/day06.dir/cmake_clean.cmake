@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/day06.dir/AdventOfCode2024/day06.cpp.o"
+  "CMakeFiles/day06.dir/AdventOfCode2024/day06.cpp.o.d"
+  "libday06.pdb"
+  "libday06.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/day06.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
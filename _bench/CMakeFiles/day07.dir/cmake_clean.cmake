@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/day07.dir/AdventOfCode2024/day07.cpp.o"
+  "CMakeFiles/day07.dir/AdventOfCode2024/day07.cpp.o.d"
+  "libday07.pdb"
+  "libday07.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/day07.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
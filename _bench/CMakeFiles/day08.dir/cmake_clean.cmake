@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/day08.dir/AdventOfCode2024/day08.cpp.o"
+  "CMakeFiles/day08.dir/AdventOfCode2024/day08.cpp.o.d"
+  "libday08.pdb"
+  "libday08.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/day08.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
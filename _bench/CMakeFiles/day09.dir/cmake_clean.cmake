@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/day09.dir/AdventOfCode2024/day09.cpp.o"
+  "CMakeFiles/day09.dir/AdventOfCode2024/day09.cpp.o.d"
+  "libday09.pdb"
+  "libday09.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/day09.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
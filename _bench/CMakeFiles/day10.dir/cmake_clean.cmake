@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/day10.dir/AdventOfCode2024/day10.cpp.o"
+  "CMakeFiles/day10.dir/AdventOfCode2024/day10.cpp.o.d"
+  "libday10.pdb"
+  "libday10.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/day10.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/day11.dir/AdventOfCode2024/day11.cpp.o"
+  "CMakeFiles/day11.dir/AdventOfCode2024/day11.cpp.o.d"
+  "libday11.pdb"
+  "libday11.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/day11.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
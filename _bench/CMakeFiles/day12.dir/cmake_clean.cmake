@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/day12.dir/AdventOfCode2024/day12.cpp.o"
+  "CMakeFiles/day12.dir/AdventOfCode2024/day12.cpp.o.d"
+  "libday12.pdb"
+  "libday12.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/day12.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/day13.dir/AdventOfCode2024/day13.cpp.o"
+  "CMakeFiles/day13.dir/AdventOfCode2024/day13.cpp.o.d"
+  "libday13.pdb"
+  "libday13.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/day13.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
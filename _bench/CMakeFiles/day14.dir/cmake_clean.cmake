@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/day14.dir/AdventOfCode2024/day14.cpp.o"
+  "CMakeFiles/day14.dir/AdventOfCode2024/day14.cpp.o.d"
+  "libday14.pdb"
+  "libday14.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/day14.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
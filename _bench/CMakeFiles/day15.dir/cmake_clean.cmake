@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/day15.dir/AdventOfCode2024/day15.cpp.o"
+  "CMakeFiles/day15.dir/AdventOfCode2024/day15.cpp.o.d"
+  "libday15.pdb"
+  "libday15.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/day15.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/day16.dir/AdventOfCode2024/day16.cpp.o"
+  "CMakeFiles/day16.dir/AdventOfCode2024/day16.cpp.o.d"
+  "libday16.pdb"
+  "libday16.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/day16.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
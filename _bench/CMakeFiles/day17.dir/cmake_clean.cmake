@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/day17.dir/AdventOfCode2024/day17.cpp.o"
+  "CMakeFiles/day17.dir/AdventOfCode2024/day17.cpp.o.d"
+  "libday17.pdb"
+  "libday17.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/day17.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/day18.dir/AdventOfCode2024/day18.cpp.o"
+  "CMakeFiles/day18.dir/AdventOfCode2024/day18.cpp.o.d"
+  "libday18.pdb"
+  "libday18.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/day18.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/day19.dir/AdventOfCode2024/day19.cpp.o"
+  "CMakeFiles/day19.dir/AdventOfCode2024/day19.cpp.o.d"
+  "libday19.pdb"
+  "libday19.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/day19.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/day20.dir/AdventOfCode2024/day20.cpp.o"
+  "CMakeFiles/day20.dir/AdventOfCode2024/day20.cpp.o.d"
+  "libday20.pdb"
+  "libday20.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/day20.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/day21.dir/AdventOfCode2024/day21.cpp.o"
+  "CMakeFiles/day21.dir/AdventOfCode2024/day21.cpp.o.d"
+  "libday21.pdb"
+  "libday21.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/day21.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
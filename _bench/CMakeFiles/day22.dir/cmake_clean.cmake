@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/day22.dir/AdventOfCode2024/day22.cpp.o"
+  "CMakeFiles/day22.dir/AdventOfCode2024/day22.cpp.o.d"
+  "libday22.pdb"
+  "libday22.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/day22.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/day23.dir/AdventOfCode2024/day23.cpp.o"
+  "CMakeFiles/day23.dir/AdventOfCode2024/day23.cpp.o.d"
+  "libday23.pdb"
+  "libday23.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/day23.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/day24.dir/AdventOfCode2024/day24.cpp.o"
+  "CMakeFiles/day24.dir/AdventOfCode2024/day24.cpp.o.d"
+  "libday24.pdb"
+  "libday24.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/day24.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
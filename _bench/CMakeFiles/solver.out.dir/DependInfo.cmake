@@ -0,0 +1,48 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/AdventOfCode2024/answer_cache.cpp" "CMakeFiles/solver.out.dir/AdventOfCode2024/answer_cache.cpp.o" "gcc" "CMakeFiles/solver.out.dir/AdventOfCode2024/answer_cache.cpp.o.d"
+  "/root/repo/AdventOfCode2024/file_watcher.cpp" "CMakeFiles/solver.out.dir/AdventOfCode2024/file_watcher.cpp.o" "gcc" "CMakeFiles/solver.out.dir/AdventOfCode2024/file_watcher.cpp.o.d"
+  "/root/repo/AdventOfCode2024/input_prefetch.cpp" "CMakeFiles/solver.out.dir/AdventOfCode2024/input_prefetch.cpp.o" "gcc" "CMakeFiles/solver.out.dir/AdventOfCode2024/input_prefetch.cpp.o.d"
+  "/root/repo/AdventOfCode2024/main.cpp" "CMakeFiles/solver.out.dir/AdventOfCode2024/main.cpp.o" "gcc" "CMakeFiles/solver.out.dir/AdventOfCode2024/main.cpp.o.d"
+  "/root/repo/AdventOfCode2024/mapped_file.cpp" "CMakeFiles/solver.out.dir/AdventOfCode2024/mapped_file.cpp.o" "gcc" "CMakeFiles/solver.out.dir/AdventOfCode2024/mapped_file.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_bench/CMakeFiles/day01.dir/DependInfo.cmake"
+  "/root/repo/_bench/CMakeFiles/day02.dir/DependInfo.cmake"
+  "/root/repo/_bench/CMakeFiles/day03.dir/DependInfo.cmake"
+  "/root/repo/_bench/CMakeFiles/day04.dir/DependInfo.cmake"
+  "/root/repo/_bench/CMakeFiles/day05.dir/DependInfo.cmake"
+  "/root/repo/_bench/CMakeFiles/day06.dir/DependInfo.cmake"
+  "/root/repo/_bench/CMakeFiles/day07.dir/DependInfo.cmake"
+  "/root/repo/_bench/CMakeFiles/day08.dir/DependInfo.cmake"
+  "/root/repo/_bench/CMakeFiles/day09.dir/DependInfo.cmake"
+  "/root/repo/_bench/CMakeFiles/day10.dir/DependInfo.cmake"
+  "/root/repo/_bench/CMakeFiles/day11.dir/DependInfo.cmake"
+  "/root/repo/_bench/CMakeFiles/day12.dir/DependInfo.cmake"
+  "/root/repo/_bench/CMakeFiles/day13.dir/DependInfo.cmake"
+  "/root/repo/_bench/CMakeFiles/day14.dir/DependInfo.cmake"
+  "/root/repo/_bench/CMakeFiles/day15.dir/DependInfo.cmake"
+  "/root/repo/_bench/CMakeFiles/day16.dir/DependInfo.cmake"
+  "/root/repo/_bench/CMakeFiles/day17.dir/DependInfo.cmake"
+  "/root/repo/_bench/CMakeFiles/day18.dir/DependInfo.cmake"
+  "/root/repo/_bench/CMakeFiles/day19.dir/DependInfo.cmake"
+  "/root/repo/_bench/CMakeFiles/day20.dir/DependInfo.cmake"
+  "/root/repo/_bench/CMakeFiles/day21.dir/DependInfo.cmake"
+  "/root/repo/_bench/CMakeFiles/day22.dir/DependInfo.cmake"
+  "/root/repo/_bench/CMakeFiles/day23.dir/DependInfo.cmake"
+  "/root/repo/_bench/CMakeFiles/day24.dir/DependInfo.cmake"
+  "/root/repo/_bench/CMakeFiles/utils.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
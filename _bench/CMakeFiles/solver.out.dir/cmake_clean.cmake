@@ -0,0 +1,19 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/solver.out.dir/AdventOfCode2024/answer_cache.cpp.o"
+  "CMakeFiles/solver.out.dir/AdventOfCode2024/answer_cache.cpp.o.d"
+  "CMakeFiles/solver.out.dir/AdventOfCode2024/file_watcher.cpp.o"
+  "CMakeFiles/solver.out.dir/AdventOfCode2024/file_watcher.cpp.o.d"
+  "CMakeFiles/solver.out.dir/AdventOfCode2024/input_prefetch.cpp.o"
+  "CMakeFiles/solver.out.dir/AdventOfCode2024/input_prefetch.cpp.o.d"
+  "CMakeFiles/solver.out.dir/AdventOfCode2024/main.cpp.o"
+  "CMakeFiles/solver.out.dir/AdventOfCode2024/main.cpp.o.d"
+  "CMakeFiles/solver.out.dir/AdventOfCode2024/mapped_file.cpp.o"
+  "CMakeFiles/solver.out.dir/AdventOfCode2024/mapped_file.cpp.o.d"
+  "solver.out"
+  "solver.out.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/solver.out.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,23 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/AdventOfCode2024/aho_corasick.cpp" "CMakeFiles/utils.dir/AdventOfCode2024/aho_corasick.cpp.o" "gcc" "CMakeFiles/utils.dir/AdventOfCode2024/aho_corasick.cpp.o.d"
+  "/root/repo/AdventOfCode2024/bit_grid.cpp" "CMakeFiles/utils.dir/AdventOfCode2024/bit_grid.cpp.o" "gcc" "CMakeFiles/utils.dir/AdventOfCode2024/bit_grid.cpp.o.d"
+  "/root/repo/AdventOfCode2024/cancellation.cpp" "CMakeFiles/utils.dir/AdventOfCode2024/cancellation.cpp.o" "gcc" "CMakeFiles/utils.dir/AdventOfCode2024/cancellation.cpp.o.d"
+  "/root/repo/AdventOfCode2024/graph.cpp" "CMakeFiles/utils.dir/AdventOfCode2024/graph.cpp.o" "gcc" "CMakeFiles/utils.dir/AdventOfCode2024/graph.cpp.o.d"
+  "/root/repo/AdventOfCode2024/utils.cpp" "CMakeFiles/utils.dir/AdventOfCode2024/utils.cpp.o" "gcc" "CMakeFiles/utils.dir/AdventOfCode2024/utils.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,19 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/utils.dir/AdventOfCode2024/aho_corasick.cpp.o"
+  "CMakeFiles/utils.dir/AdventOfCode2024/aho_corasick.cpp.o.d"
+  "CMakeFiles/utils.dir/AdventOfCode2024/bit_grid.cpp.o"
+  "CMakeFiles/utils.dir/AdventOfCode2024/bit_grid.cpp.o.d"
+  "CMakeFiles/utils.dir/AdventOfCode2024/cancellation.cpp.o"
+  "CMakeFiles/utils.dir/AdventOfCode2024/cancellation.cpp.o.d"
+  "CMakeFiles/utils.dir/AdventOfCode2024/graph.cpp.o"
+  "CMakeFiles/utils.dir/AdventOfCode2024/graph.cpp.o.d"
+  "CMakeFiles/utils.dir/AdventOfCode2024/utils.cpp.o"
+  "CMakeFiles/utils.dir/AdventOfCode2024/utils.cpp.o.d"
+  "libutils.pdb"
+  "libutils.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/utils.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,34 @@
+# Run as a script at build time:
+#   cmake -DSOURCE_DIR=... -DOUTPUT=... -DVERSION=... [-DBUILD_ID=...] -P ...
+#
+# Writes OUTPUT, a header defining SOLVER_BUILD_ID as VERSION followed by a
+# hash of CMakeLists.txt and every solver source, or as BUILD_ID if that is
+# not empty. The header is only rewritten when the id changes, so a build
+# with no source changes does not recompile anything.
+
+IF(BUILD_ID STREQUAL "")
+	FILE(GLOB SOURCES
+		"${SOURCE_DIR}/AdventOfCode2024/*.cpp"
+		"${SOURCE_DIR}/AdventOfCode2024/*.hpp"
+	)
+	LIST(SORT SOURCES)
+	SET(DIGESTS "")
+	FOREACH(SOURCE "${SOURCE_DIR}/CMakeLists.txt" ${SOURCES})
+		FILE(SHA256 "${SOURCE}" DIGEST)
+		FILE(RELATIVE_PATH NAME "${SOURCE_DIR}" "${SOURCE}")
+		STRING(APPEND DIGESTS "${NAME} ${DIGEST}\n")
+	ENDFOREACH()
+	STRING(SHA256 TREE_DIGEST "${DIGESTS}")
+	STRING(SUBSTRING "${TREE_DIGEST}" 0 16 TREE_DIGEST)
+	SET(BUILD_ID "${VERSION}-${TREE_DIGEST}")
+ENDIF()
+
+SET(CONTENTS "#define SOLVER_BUILD_ID \"${BUILD_ID}\"\n")
+IF(EXISTS "${OUTPUT}")
+	FILE(READ "${OUTPUT}" OLD_CONTENTS)
+ELSE()
+	SET(OLD_CONTENTS "")
+ENDIF()
+IF(NOT CONTENTS STREQUAL OLD_CONTENTS)
+	FILE(WRITE "${OUTPUT}" "${CONTENTS}")
+ENDIF()